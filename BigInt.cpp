@@ -1,405 +1,519 @@
-#include <iostream>
-#include <vector>
-#include <string>
-#include <bitset>
-#include <algorithm>
-#include<algorithm>  
-#include<iterator> 
-#include <deque>
-
-
-class BigInt {
-public:
-    BigInt() {
-    }
-    BigInt(unsigned int num) {
-        blocks.push_back(num);
-    }
-    //copy const
-    BigInt(const BigInt& other){
-        this->blocks = other.blocks;
-    } 
-    //move const
-    BigInt(BigInt&& other){
-        this->blocks.clear();
-        copy(other.blocks.begin(), other.blocks.end(), back_inserter(this->blocks));  
-    }
-    
+#include "BigInt.h"
 
-    void setHex(const std::string& hexStr) {
-        blocks.clear();
-        for (size_t i = hexStr.length() - 1; i >= 0; i -= 8) {
-            size_t chunkStart = (i >= 8) ? (i - 7) : 0;
-            std::string chunk = hexStr.substr(chunkStart, i - chunkStart + 1);
-            blocks.push_back(std::stoul(chunk, 0, 16));
-            if (chunkStart == 0)
-                break;
-        }
-        delete_empty_blocks();
+#include <sstream>
 
-    }
-    std::string getHex() const {
-        std::string hexStr;
-        for (int i = blocks.size() - 1; i >= 0; --i) {
-            char chunkHex[9];
-            std::sprintf(chunkHex, "%08X", blocks[i]);
-            hexStr += chunkHex;
-        }
-        return hexStr;
-    }
-    void setBin(const std::string& binStr) {
-        blocks.clear();
-        size_t start = 0;
-        for (size_t i = binStr.length() - 1; i >= 0; i -= 32) {
-            size_t chunkStart = (i >= 32) ? (i - 31) : 0;
-            std::string chunk = binStr.substr(chunkStart, i - chunkStart + 1);
-            blocks.push_back(std::stoul(chunk, 0, 2));
-            if (chunkStart == 0)
-                break;
-        }
-        delete_empty_blocks();
-    }
-    std::string getBin() const {
-        std::string binStr;
-        for (int i = blocks.size() - 1; i >= 0; --i) {
-            std::bitset<32> binChunk(blocks[i]);
-            binStr += binChunk.to_string();
-        }
-        return binStr;
-    }
-    //bits operations
-    
-    //INV
-    BigInt operator~() {
-        BigInt result(*this);
-        if (result.blocks.size() == 1){
-            if(result.blocks.back() == 0){
-                result.blocks.back() = 1;
-                return result;
-            }
-            result._INV_for_last_block();
-            return result;
-        }
-        for (size_t i = 0; i < result.blocks.size() - 1; ++i) {
-            result.blocks[i] = ~result.blocks[i];
-        }
-        result._INV_for_last_block();
-        result.delete_empty_blocks();
-        return result;
-    }
-    //xor
-    BigInt operator^ (const BigInt& other) const{
-        BigInt result;
-        size_t m = blocks.size();
-        size_t n = other.blocks.size();
-        size_t maxSize = std::max(m, n);
-        for (int i = 0; i < maxSize; ++i) {
-            if (i > m - 1){
-                result.blocks.push_back(0 ^ other.blocks[i]);
-                continue;   
-            }
-            if (i > n - 1){
-                result.blocks.push_back(blocks[i] ^ 0);
-                continue;
-            }
-            result.blocks.push_back(blocks[i] ^ other.blocks[i]);
-        }
-        result.delete_empty_blocks();
-        return result;
-    }
 
-    //or
-    BigInt operator| (const BigInt& other){
-        BigInt result; 
-        size_t maxSize = std::max(blocks.size(), other.blocks.size());
-        if (blocks.size() < other.blocks.size()) {
-            blocks.resize(other.blocks.size(), 0);
-        }
-        for (size_t i = 0; i < maxSize; ++i) {
-            if (i < other.blocks.size()) {
-                result.blocks.push_back(blocks[i] | other.blocks[i]);
-            }
-        }
-        delete_empty_blocks();
-        result.delete_empty_blocks();
-        return result;
-    }
+//functions for answer check
+std::string make_correct_len(std::string str, const int base){
+    int mod = (str).length() % base;
+    if(mod != 0)
+        (str).insert(0, base - mod, '0');
+    std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+    return str;
 
-    //and
-    BigInt operator& (const BigInt& other) const{
-        BigInt result;
-        size_t minSize = std::min(blocks.size(), other.blocks.size());
-        for (size_t i = 0; i < minSize; ++i) {
-            result.blocks.push_back(blocks[i] & other.blocks[i]);
-        }
-        result.delete_empty_blocks();
-        return result;
+}
+bool compare (std::string ans, std::string result){
+    return ans == result;
+}
+//true when f throws an E
+template <class E, class F>
+bool throws(F f){
+    try {
+        f();
     }
-    //shift left
-    BigInt operator<< (int n) {
-        BigInt result(*this); 
-        if (n <= 0) {
-            return result; 
-        }
-        if (n>= 32){
-            result = *this << (n%32);
-            for(int i = 1; i <= n / 32; i++)
-                result.blocks.push_front(0);
-            return result;
-        }
-        int carry = 0;
-        for (int i = 0; i < result.blocks.size(); ++i) {
-            unsigned int shifted = result.blocks[i] << n;
-            shifted |= carry;  
-            carry = result.blocks[i] >> (32 - n);
-            result.blocks[i] = shifted;
-        }
-        if (carry != 0) {
-            result.blocks.push_back(carry);
-        }
-        result.delete_empty_blocks();
-        return result;
+    catch (const E&) {
+        return true;
     }
-    
-    //shift right
-    BigInt operator>> (int n) {
-        BigInt result(*this); 
-        if (n <= 0) {
-            return result;
-        }
-        if (n>= 32){
-            for(int i = 1; i <= n / 32; i++)
-                result.blocks.pop_front();
-            return result >> (n % 32);
-        }
+    return false;
+}
 
-        int carry = 0;
-        for (int i = result.blocks.size() - 1; i >= 0; --i) {
-            unsigned int shifted = result.blocks[i] >> n;
-            shifted |= carry << (32 - n); 
-            carry = (result.blocks[i] & ((1 << n) - 1)); 
-            result.blocks[i] = shifted;
-        }
-        result.delete_empty_blocks();
-        return result;
-    }
+//a * e.x + b * e.y == e.gcd, with 0 <= x < b / gcd, and the gcd divides both a and b
+bool check_extended_gcd(const BigInt& a, const BigInt& b, const ExtendedGcd& e){
+    SignedBigInt sum = SignedBigInt::Add(SignedBigInt::Mul(SignedBigInt{a}, e.x),
+                                         SignedBigInt::Mul(SignedBigInt{b}, e.y));
+    return !sum.negative && sum.value == e.gcd && !e.x.negative && e.x.value < b / e.gcd
+        && (a % e.gcd).isZero() && (b % e.gcd).isZero();
+}
 
-    //arifmetical operations
-    //add
-    BigInt operator+(const BigInt& other) const{
-        BigInt result;
-        unsigned int carry = 0;
-        size_t max_size = std::max(blocks.size(), other.blocks.size());
-        for (size_t i = 0; i < max_size || carry; ++i) {
-            if (i == result.blocks.size()) {
-                result.blocks.push_back(0);
-            }
-            unsigned long long sum = result.blocks[i];
-            if (i < blocks.size()) {
-                sum += blocks[i];
-            }
-            if (i < other.blocks.size()) {
-                sum += other.blocks[i];
-            }
-            sum += carry;
-            result.blocks[i] = static_cast<unsigned int>(sum);
-            carry = static_cast<unsigned int>(sum >> 32);
-        }
-        result.delete_empty_blocks();
-        return result;
-    }
-    // subtitude
-    BigInt operator- (const BigInt& other) const{
-        BigInt result;
-        size_t max_size = blocks.size();
-        result.blocks.resize(max_size);
-
-        unsigned long long borrow = 0;
-        for (size_t i = 0; i < max_size; ++i) {
-            long long diff = static_cast<unsigned long long>(blocks[i]);
-            if (i < other.blocks.size()) {
-                diff -= static_cast<unsigned long long>(other.blocks[i]);
-            }
-            diff -=borrow;
-
-            if (diff < 0){
-                diff += (1ULL << 32);    
-                borrow = 1;
-            }
-            else{
-                borrow = 0;
-            }
-            result.blocks[i] = static_cast<unsigned int>(diff);
-        }
+//count random digits from alphabet, the first one not '0'
+std::string random_digits(size_t count, const std::string& alphabet, std::mt19937_64& rng){
+    std::string digits(count, '0');
+    for (char& c : digits)
+        c = alphabet[rng() % alphabet.size()];
+    if (digits[0] == '0')
+        digits[0] = alphabet[1];
+    return digits;
+}
 
-        result.delete_empty_blocks();
+void test_serialize(){
+    std::cout <<"For SERIALIZE:"<< std::endl;
+    std::mt19937_64 rng(12);
+    BigInt num = BigInt::random(3000, rng);
+    std::string bytes(num.serializedSize(), '\0');
+    num.serialize(&bytes[0]);
+    std::stringstream stream;
+    num.serialize(stream);
+    bool roundTrip = BigInt::deserialize(bytes.data(), bytes.size()) == num
+        && BigInt::deserialize(stream) == num && BigInt::deserialize(bytes.data(), bytes.size()).serializedSize() == bytes.size();
+    std::cout <<"Correct : " <<roundTrip<<std::endl;
+    //limbs of 32 bits, as written on a 32-bit host
+    char words[SerializedHeader::SIZE + 12];
+    SerializedHeader{4, 3}.Write(words);
+    for (int i = 0; i < 3; ++i)
+        SerializedHeader::StoreLE(words + SerializedHeader::SIZE + 4 * i, 0x11111111u * (i + 1), 4);
+    std::string out = "333333332222222211111111";
+    std::string result = BigInt::deserialize(words, sizeof(words)).getHex();
+    std::cout << "Expect: " << out<<std::endl;
+    std::cout << "Result: " << result << std::endl;
+    std::cout <<"Correct : " <<compare(out, result)<<std::endl;
+    bool errors = throws<std::length_error>([&] { BigInt::deserialize(bytes.data(), bytes.size() - 1); })
+        && throws<std::invalid_argument>([&] { BigInt::deserialize(out.data(), out.size()); });
+    std::cout <<"Correct : " <<errors<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
 
-        return result;
-    }
-    //mod
-    unsigned int operator% (unsigned int mod) const{
-        unsigned int result = 0;
-        for (int i = blocks.size() - 1; i >= 0; --i) {
-            for(int j = 7; j >= 0; --j) {
-                result = (result * 16 + ((blocks[i] >> (4*j)) & 0xF)) % mod;
-            }
-        }
-        return result;
-    }
-    //other operator overload
-    BigInt& operator=(const BigInt& other){
-        if (this != &other) {
-            blocks = other.blocks;
-        }
-        return *this;
+    std::cout <<"For BIGINTVIEW:"<< std::endl;
+    //deserialize copies into aligned limbs, a view reads them in place
+    std::vector<Limb> aligned((bytes.size() + sizeof(Limb) - 1) / sizeof(Limb));
+    std::memcpy(aligned.data(), bytes.data(), bytes.size());
+    BigIntView view = BigIntView::fromSerialized(reinterpret_cast<const char*>(aligned.data()), bytes.size());
+    bool views = BigInt(view) == num && num + view == num + num && BigInt(view.slice(1, 2)) == (num >> 64) % (BigInt(1) << 128);
+    std::cout <<"Correct : " <<views<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
+
+void test_hex_bin(){
+    std::cout <<"For HEX and BIN, several thousand digits:"<< std::endl;
+    std::mt19937_64 rng(9);
+    std::string inp = random_digits(4001, "0123456789abcdefABCDEF", rng);
+    BigInt num;
+    num.setHex(inp);
+    std::cout <<"Correct : " <<compare(make_correct_len(inp, 8), num.getHex())<<std::endl;
+    inp = random_digits(5003, "01", rng);
+    num.setBin(inp);
+    std::cout <<"Correct : " <<compare(make_correct_len(inp, 32), num.getBin())<<std::endl;
+    //bad digits in a full 16-digit (8-digit for binary) chunk and in the short head
+    bool invalid = throws<std::invalid_argument>([&] { num.setHex("0123456789abcdeg0123"); })
+        && throws<std::invalid_argument>([&] { num.setHex("x0123456789abcdef"); })
+        && throws<std::invalid_argument>([&] { num.setBin("10110101121"); })
+        && throws<std::invalid_argument>([&] { num.setBin(" 1011010110"); });
+    std::cout <<"Correct : " <<invalid<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
+
+void test_decimal(){
+    std::cout <<"For DEC, several thousand digits:"<< std::endl;
+    std::mt19937_64 rng(8);
+    std::string inp = random_digits(5000, "0123456789", rng);
+    BigInt num;
+    num.setDec(inp);
+    std::cout <<"Correct : " <<compare(inp, num.getDec())<<std::endl;
+    std::string out = "1" + std::string(4000, '0');
+    std::cout <<"Correct : " <<compare(out, pow(BigInt(10), 4000).getDec())<<std::endl;
+    num.setDec("000123");
+    std::cout <<"Correct : " <<compare("123", num.getDec())<<std::endl;
+    bool invalid = throws<std::invalid_argument>([&] { num.setDec(""); })
+        && throws<std::invalid_argument>([&] { num.setDec("12a3"); })
+        && throws<std::invalid_argument>([&] { num.setDec(inp + "-"); });
+    std::cout <<"Correct : " <<invalid<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
+
+void test_division(){
+    std::cout <<"For DIVMOD:"<< std::endl;
+    std::mt19937_64 rng(4);
+    bool correct = true;
+    //Knuth D below BigInt::divThresholds().burnikelZiegler limbs, Burnikel-Ziegler above
+    for (size_t limbs : {size_t(1), size_t(2), size_t(10), BigInt::divThresholds().burnikelZiegler + 40, size_t(400)}) {
+        BigInt b = BigInt::random(limbs * 64, rng) | (BigInt(1) << (limbs * 64 - 1));
+        BigInt a = BigInt::random(limbs * 64 * 3 + 17, rng);
+        std::pair<BigInt, BigInt> qr = divmod(a, b);
+        correct = correct && qr.first * b + qr.second == a && qr.second < b;
     }
-    bool operator< (const BigInt& other) const{
-        if (&other == nullptr)
-            return false;
-        if (blocks.size() < other.blocks.size())
-            return true;
-        if (blocks.size() > other.blocks.size())
-            return false;
-        for (size_t i = 0; i <blocks.size(); i++){
-            if(blocks[i] < other.blocks[i])
-                return true;
-            if(blocks[i] > other.blocks[i])
-                return false;
-        }
-        return false;
+    std::cout <<"Correct : " <<correct<<std::endl;
+    std::cout <<"Correct : " <<throws<std::domain_error>([] { divmod(BigInt(5), BigInt(0)); })<<std::endl;
+    std::cout <<"Correct : " <<throws<std::domain_error>([] { BigInt(5) % 0u; })<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
+
+void test_residues(){
+    std::cout <<"For RESIDUES:"<< std::endl;
+    std::mt19937_64 rng(7);
+    std::vector<uint32_t> moduli = {1u, 0xFFFFFFFFu, 2u, 3u, 65537u};
+    while (moduli.size() < 40)
+        moduli.push_back(static_cast<uint32_t>(rng()) | 1u);
+    bool correct = true;
+    //one pass over the limbs below the remainder-tree cutoff, the tree above it
+    for (size_t limbs : {size_t(5), size_t(300)}) {
+        BigInt num = BigInt::random(limbs * 64, rng);
+        std::vector<uint32_t> residues = num.residues(moduli);
+        for (size_t j = 0; j < moduli.size(); ++j)
+            correct = correct && residues[j] == num % moduli[j];
     }
-    bool operator> (const BigInt& other) const{
-        if (&other == nullptr)
-            return false;
-        if (blocks.size() > other.blocks.size())
-            return true;
-        if (blocks.size() < other.blocks.size())
-            return false;
-        for (size_t i = 0; i <blocks.size(); i++){
-            if(blocks[i] > other.blocks[i])
-                return true;
-            if(blocks[i] < other.blocks[i])
-                return false;
-        }
-        return false;
+    std::cout <<"Correct : " <<correct<<std::endl;
+    std::cout <<"Correct : " <<throws<std::domain_error>([] { BigInt(5).residues({3u, 0u}); })<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
+
+void test_montgomery(){
+    std::cout <<"For POWMOD:"<< std::endl;
+    MontgomeryContext small(BigInt(497));
+    std::string out = "445";
+    std::string result = small.powmod(BigInt(4), BigInt(13)).getDec();
+    std::cout << "Expect: " << out<<std::endl;
+    std::cout << "Result: " << result << std::endl;
+    std::cout <<"Correct : " <<compare(out, result)<<std::endl;
+    //Fermat: a^(p - 1) = 1 mod p for the prime p = 2^521 - 1
+    BigInt p = pow(BigInt(2), 521) - BigInt(1);
+    MontgomeryContext ctx(p);
+    std::mt19937_64 rng(5);
+    std::vector<BigInt> bases;
+    for (int i = 0; i < 4; ++i)
+        bases.push_back(BigInt::random(520, rng) + BigInt(2));
+    bool fermat = true;
+    for (const BigInt& base : ctx.powmodBatch(bases, {p - BigInt(1)}))
+        fermat = fermat && base == BigInt(1);
+    std::cout <<"Correct : " <<fermat<<std::endl;
+    BigInt e = BigInt::random(700, rng);
+    std::cout <<"Correct : " <<(ctx.powmodBatch(bases, {e})[2] == ctx.powmod(bases[2], e))<<std::endl;
+    std::cout <<"Correct : " <<throws<std::invalid_argument>([] { MontgomeryContext even(BigInt(100)); })<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
+
+void test_barrett(){
+    std::cout <<"For BARRETT:"<< std::endl;
+    std::mt19937_64 rng(6);
+    //an even modulus, which Montgomery can't take
+    BigInt m = (BigInt::random(300, rng) | (BigInt(1) << 299)) << 1;
+    BarrettReducer reducer(m);
+    bool correct = true;
+    for (int i = 0; i < 8; ++i) {
+        BigInt x = BigInt::random(i < 7 ? 600 : 1000, rng);
+        BigInt a = BigInt::random(300, rng), b = BigInt::random(300, rng);
+        correct = correct && reducer.reduce(x) == x % m && reducer.multiply(a, b) == a * b % m;
     }
-    bool operator== (const BigInt& other) const{
-        if (&other == nullptr)
-            return false;
-        if (blocks.size() != other.blocks.size())
-            return false;
-        for (size_t i = 0; i <blocks.size(); i++){
-            if(blocks[i] != other.blocks[i])
-                return false;
+    std::cout <<"Correct : " <<correct<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
+
+void test_roots(){
+    std::cout <<"For ISQRT and IROOT:"<< std::endl;
+    std::mt19937_64 rng(21);
+    bool correct = true;
+    //roots of a double's size and far above it
+    for (size_t bits : {size_t(20), size_t(50), size_t(2000)}) {
+        BigInt r = BigInt::random(bits, rng) | (BigInt(1) << (bits - 1));
+        BigInt square = r.square();
+        correct = correct && isqrt(square) == r && isqrt(square - BigInt(1)) == r - BigInt(1);
+        for (uint64_t k : {3, 7}) {
+            BigInt power = pow(r, k);
+            correct = correct && iroot(power, k) == r && iroot(power - BigInt(1), k) == r - BigInt(1);
         }
-        return true;
     }
-    bool operator>= (const BigInt& other) const{
-        if((*this) > other || (*this) == other)
-            return true;
-        return false;
-    }
-    
-    bool operator<= (const BigInt& other) const{
-        if((*this) < other || (*this) == other)
-            return true;
-        return false;
-    }
-    //mul
-    BigInt operator* (const BigInt& other) const {
-        size_t n = blocks.size();
-        size_t m = other.blocks.size();
+    std::cout <<"Correct : " <<correct<<std::endl;
+    std::cout <<"Correct : " <<throws<std::domain_error>([] { iroot(BigInt(8), 0); })<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
 
-        if (n == 0 || m == 0) {
-            return BigInt(0);
-        }
+    std::cout <<"For PERFECT POWERS:"<< std::endl;
+    BigInt r = BigInt::random(500, rng) | (BigInt(1) << 499) | BigInt(1);
+    BigInt root;
+    uint64_t exponent = 0;
+    //r^2 + 64 passes the filter mod 64, r^2 + 64 * 63 * 65 * 11 all of them
+    bool squares = is_perfect_square(r.square(), &root) && root == r
+        && !is_perfect_square(r.square() + BigInt(64))
+        && !is_perfect_square(r.square() + BigInt(64 * 45045)) && !is_perfect_square(BigInt(17));
+    std::cout <<"Correct : " <<squares<<std::endl;
+    bool powers = is_perfect_power(pow(r, 5), &root, &exponent) && root == r && exponent == 5
+        && is_perfect_power(pow(r, 15), &root, &exponent) && root == pow(r, 5) && exponent == 3
+        && !is_perfect_power(pow(r, 5) + BigInt(1)) && !is_perfect_power(r);
+    std::cout <<"Correct : " <<powers<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
 
-        if (n == 1 || m == 1) {
-            return MultiplyBySingleBlock(other);
+void test_shifts(){
+    std::cout <<"For SHIFTS by 0, by whole limbs and past the bit length:"<< std::endl;
+    std::mt19937_64 rng(11);
+    std::string bits = random_digits(1000, "01", rng);
+    BigInt num;
+    num.setBin(bits);
+    bool correct = (BigInt(0) << 640).isZero() && (BigInt(0) >> 64).isZero();
+    //in place, on a copy and on a temporary
+    for (size_t n : {size_t(0), size_t(64), size_t(640), size_t(999), size_t(1000), size_t(4000)}) {
+        std::string left = make_correct_len(bits + std::string(n, '0'), 32);
+        BigInt x = num;
+        x <<= n;
+        correct = correct && x.getBin() == left && (num << n).getBin() == left && (BigInt(num) << n).getBin() == left;
+        BigInt y = num;
+        y >>= n;
+        if (n < bits.size()) {
+            std::string right = make_correct_len(bits.substr(0, bits.size() - n), 32);
+            correct = correct && y.getBin() == right && (num >> n).getBin() == right && (BigInt(num) >> n).getBin() == right;
+        }
+        else {
+            correct = correct && y.isZero() && (num >> n).isZero() && (BigInt(num) >> n).isZero();
         }
+    }
+    std::cout <<"Correct : " <<correct<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
 
-        size_t maxLen = std::max(n, m);
-        size_t halfLen = maxLen / 2;
+void test_parallel(){
+    std::cout <<"For MUL, parallel against serial:"<< std::endl;
+    std::mt19937_64 rng(10);
+    bool same = true;
+    //Toom-3 and NTT sizes above BigInt::parallelism().cutoff
+    for (size_t limbs : {size_t(2000), size_t(5000)}) {
+        size_t bits = (BigInt::parallelism().cutoff + limbs) * 64;
+        BigInt a = BigInt::random(bits, rng), b = BigInt::random(bits - 100, rng);
+        BigInt serial = a * b, serialSquare = a.square();
+        BigInt::parallelism().threads = 4;
+        BigInt parallel = a * b, parallelSquare = a.square();
+        BigInt::parallelism().threads = 1;
+        same = same && serial == parallel && serialSquare == parallelSquare;
+    }
+    std::cout <<"Correct : " <<same<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
 
-        BigInt a0, a1, b0, b1;
-        SplitInHalf(a0, a1, halfLen);
-        other.SplitInHalf(b0, b1, halfLen);
+void test_lazy(){
+    std::cout <<"For LAZY sums:"<< std::endl;
+    std::mt19937_64 rng(22);
+    BigInt a = BigInt::random(5000, rng) | (BigInt(1) << 4999);
+    BigInt b = BigInt::random(3000, rng), c = BigInt::random(4000, rng);
+    BigInt expect = (a + b - c) << 77;
+    BigInt result = lazy(a) + b - c << 77;
+    std::cout <<"Correct : " <<(result == expect)<<std::endl;
+    result = (lazy(c) << 1000) - (lazy(b) << 999) + a;
+    std::cout <<"Correct : " <<(result == (c << 1000) - (b << 999) + a)<<std::endl;
+    //the target is one of the terms
+    expect = a + a;
+    a = lazy(a) + a;
+    std::cout <<"Correct : " <<(a == expect)<<std::endl;
+    std::cout <<"Correct : " <<throws<std::domain_error>([&] { BigInt r = lazy(b) - a; })<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
 
-        BigInt p1 = a1*b1;
-        BigInt p2 = a0*b0;
-        BigInt p3 = (a0 + a1)*(b0 + b1) - p1 - p2;
+void test_batch(){
+    std::cout <<"For BIGINTBATCH:"<< std::endl;
+    std::mt19937_64 rng(14);
+    //more lanes than a vector block, so the scalar tail runs too
+    std::vector<BigInt> a, b;
+    for (int i = 0; i < 19; ++i) {
+        a.push_back(BigInt::random(64 * 6 - i, rng));
+        b.push_back(BigInt::random(64 * 6, rng));
+    }
+    BigIntBatch x(a, 6), y(b, 6);
+    std::vector<BigInt> products = (x * y).toBigInts();
+    std::vector<BigInt> sums = (x + y).toBigInts();
+    std::vector<int> order = x.compare(y);
+    BigInt wrap = BigInt(1) << (64 * 6);
+    bool correct = products.size() == a.size();
+    for (size_t i = 0; i < a.size() && correct; ++i) {
+        int expect = a[i] < b[i] ? -1 : (a[i] == b[i] ? 0 : 1);
+        correct = products[i] == a[i] * b[i] && sums[i] == (a[i] + b[i]) % wrap && order[i] == expect;
+    }
+    std::cout <<"Correct : " <<correct<<std::endl;
+    //the lanes with a < b borrow out of the top limb and wrap
+    BigIntBatch z = x;
+    z -= y;
+    std::vector<BigInt> differences = (x - y).toBigInts(), inPlace = z.toBigInts();
+    bool borrows = std::count(order.begin(), order.end(), -1) > 0;
+    for (size_t i = 0; i < a.size() && borrows; ++i)
+        borrows = differences[i] == (a[i] + wrap - b[i]) % wrap && inPlace[i] == differences[i];
+    std::cout <<"Correct : " <<borrows<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
 
-        p1 = p1 << (halfLen * 2 * 32);
-        p3 = p3 << (halfLen * 32);
-        return p1 + p2 + p3;
+    std::cout <<"For BIGINTBATCH reduce:"<< std::endl;
+    //3-limb moduli for 6-limb lanes; mu of 2^128 has 5 limbs, one more than usual
+    bool reduced = true;
+    for (const BigInt& m : {BigInt::random(64 * 3, rng) | (BigInt(1) << 150), BigInt(1) << 128}) {
+        BarrettReducer reducer(m);
+        std::vector<BigInt> residues = x.reduce(reducer).toBigInts();
+        for (size_t i = 0; i < a.size(); ++i)
+            reduced = reduced && residues[i] == a[i] % m;
     }
+    std::cout <<"Correct : " <<reduced<<std::endl;
+    std::cout <<"Correct : " <<throws<std::length_error>([&] { x.reduce(BarrettReducer(BigInt(7))); })<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
 
+void test_fixed(){
+    std::cout <<"For FIXEDBIGINT:"<< std::endl;
+    //the MUL case from the document, evaluated by the compiler
+    constexpr FixedBigInt<128> x = FixedBigInt<128>::fromHex("7d7deab2affa38154326e96d350deee1");
+    constexpr FixedBigInt<128> y = FixedBigInt<128>::fromHex("97f92a75b3faf8939e8e98b96476fd22");
+    constexpr FixedBigInt<256> product = x.widening_mul(y);
+    static_assert(product == FixedBigInt<256>::fromHex("4a7f69b908e167eb0dc9af7bbaa5456039c38359e4de4f169ca10c44d0a416e2"),
+                  "constexpr FixedBigInt product");
+    static_assert(x * y == FixedBigInt<128>::fromHex("39c38359e4de4f169ca10c44d0a416e2"), "product modulo 2^128");
+    BigInt num, num2;
+    num.setHex(x.getHex());
+    num2.setHex(y.getHex());
+    std::cout << "Expect: " << (num * num2).getHex()<<std::endl;
+    std::cout << "Result: " << product.getHex() << std::endl;
+    std::cout <<"Correct : " <<compare((num * num2).getHex(), product.getHex())<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
 
-private:
-    void SplitInHalf(BigInt& high, BigInt& low, size_t halfLen) const {
-        if (halfLen < blocks.size()) {
-            high.blocks.assign(blocks.begin(), blocks.begin() + halfLen);
-            low.blocks.assign(blocks.begin() + halfLen, blocks.end());
-        } else {
-            high = BigInt(0);
-            low = *this;
-        }
+void test_arena(){
+    std::cout <<"For MUL on an arena and a memory resource:"<< std::endl;
+    std::mt19937_64 rng(16);
+    size_t largest = 2 * BigInt::mulThresholds().toom3;
+    LimbArena arena(BigInt::multiplyScratch(largest));
+    bool correct = true;
+    //schoolbook, Karatsuba and the Toom-3 fallback, all on the same arena
+    for (size_t limbs : {size_t(3), size_t(40), BigInt::mulThresholds().karatsuba * 2, largest}) {
+        BigInt a = BigInt::random(limbs * 64, rng), b = BigInt::random(limbs * 64 - 50, rng);
+        correct = correct && BigInt::multiply(a, b, arena) == a * b;
     }
+    std::cout <<"Correct : " <<correct<<std::endl;
+    std::pmr::monotonic_buffer_resource pool;
+    BigInt x(pool), y(3, pool);
+    BigInt a = BigInt::random(3000, rng), b = BigInt::random(2000, rng);
+    x += a;
+    x *= b;
+    x -= b;
+    //a move between resources copies the limbs
+    BigInt c = a;
+    y = std::move(c);
+    BigInt moved = std::move(x);
+    std::cout <<"Correct : " <<(moved == a * b - b && y == a)<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
 
-    BigInt MultiplyBySingleBlock(const BigInt& other) const {
-        if (blocks.empty() || other.blocks.empty()) {
-            return BigInt(0);
-        }
-        if ((*this) < other){
-            return other.MultiplyBySingleBlock(*this);
-        }
-        BigInt result;
-        result.blocks.resize(blocks.size() + other.blocks.size(), 0);
-
-        unsigned long long carry = 0;
+void test_square(){
+    std::cout <<"For SQUARE and POW:"<< std::endl;
+    std::mt19937_64 rng(17);
+    bool correct = true;
+    for (size_t limbs : {size_t(1), size_t(5), size_t(50), size_t(300), size_t(4000)}) {
+        BigInt a = BigInt::random(limbs * 64, rng);
+        correct = correct && a.square() == a * a;
+    }
+    std::cout <<"Correct : " <<correct<<std::endl;
+    std::string out = "12157665459056928801";
+    std::cout << "Expect: " << out<<std::endl;
+    std::cout << "Result: " << pow(BigInt(3), 40).getDec() << std::endl;
+    std::cout <<"Correct : " <<compare(out, pow(BigInt(3), 40).getDec())<<std::endl;
+    BigInt a = BigInt::random(1000, rng);
+    std::cout <<"Correct : " <<(pow(a, 0) == BigInt(1) && pow(a, 7) == a.square().square() * a.square() * a)<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
 
-        for (size_t i = 0; i < blocks.size(); ++i) {
-            unsigned long long product = static_cast<unsigned long long>(blocks[i]) * other.blocks[0];
-            product += carry;
-            product += result.blocks[i];
-            result.blocks[i] = static_cast<unsigned int>(product);
-            carry = product >> 32;
-        }
+//B^limbs - 1 with B = 2^64: every limb all ones, so every carry and borrow ripples
+BigInt all_ones(size_t limbs){
+    return (BigInt(1) << (64 * limbs)) - BigInt(1);
+}
 
-        if (carry > 0) {
-            result.blocks[blocks.size()] = static_cast<unsigned int>(carry);
-        }
-        result.delete_empty_blocks();
-        return result;
-    }
-    void _INV_for_last_block(){
-        unsigned int lastBlock = blocks.back();
-        int leadingZeros = __builtin_clz(lastBlock);
-        if (leadingZeros < 32) {
-            lastBlock ^= ((1u << (32 - leadingZeros)) - 1);
-        }
-        blocks.back() = lastBlock;
-    }
-    void delete_empty_blocks(){
-        while (!blocks.empty() && blocks.back() == 0 && blocks.size() != 1) {
-            blocks.pop_back();
-        }
+void test_kernels(){
+    std::cout <<"For LIMB KERNELS, carry chains:"<< std::endl;
+    bool correct = true;
+    //the kernels take 4 limbs a step, the lengths cover every remainder
+    for (size_t n = 1; n <= 13; ++n) {
+        BigInt ones = all_ones(n), power = BigInt(1) << (64 * n);
+        correct = correct && ones + ones == (power << 1) - BigInt(2)
+            && power - ones == BigInt(1) && ones + BigInt(1) == power
+            && ones * all_ones(1) == (ones << 64) - ones
+            && ones * ones == (power << (64 * n)) - (power << 1) + BigInt(1);
+        //all-ones divisors make Knuth D overestimate its quotient digits
+        BigInt a = all_ones(3 * n + 2);
+        std::pair<BigInt, BigInt> qr = divmod(a, ones - BigInt(1));
+        correct = correct && qr.first * (ones - BigInt(1)) + qr.second == a && qr.second < ones - BigInt(1);
     }
-    std::deque<unsigned int> blocks;
-};
+    std::cout <<"Correct : " <<correct<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+}
 
+void test_gcd(){
+    std::cout <<"For GCD:"<< std::endl;
+    BigInt a = pow(BigInt(2), 200) * pow(BigInt(3), 5) * BigInt(7);
+    BigInt b = pow(BigInt(2), 150) * pow(BigInt(3), 9) * BigInt(11);
+    std::string out = (pow(BigInt(2), 150) * pow(BigInt(3), 5)).getHex();
+    BigInt g = gcd(a, b);
+    std::cout << "Expect: " << out<<std::endl;
+    std::cout << "Result: " << g.getHex() << std::endl;
+    std::cout <<"Correct : " <<compare(out, g.getHex())<<std::endl;
+    std::cout <<"Correct : " <<check_extended_gcd(a, b, extended_gcd(a, b))<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
 
-//functions for answer check
-std::string make_correct_len(std::string str, const int base){
-    int mod = (str).length() % base;
-    if(mod != 0)
-        (str).insert(0, base - mod, '0');
-    std::transform(str.begin(), str.end(), str.begin(), ::toupper);
-    return str;
+    std::cout <<"For GCD, Lehmer and half-gcd:"<< std::endl;
+    std::mt19937_64 rng(20);
+    BigInt common = BigInt::random(3000, rng) | BigInt(1);
+    a = BigInt::random(40000, rng) * common;
+    b = BigInt::random(39000, rng) * common;
+    ExtendedGcd lehmer = extended_gcd(a, b);
+    BigInt::GcdThresholds saved = BigInt::gcdThresholds();
+    BigInt::gcdThresholds().halfGcd = 100;
+    BigInt::gcdThresholds().halfGcdBase = 40;
+    ExtendedGcd half = extended_gcd(a, b);
+    BigInt halfGcd = gcd(a, b);
+    BigInt::gcdThresholds() = saved;
+    std::cout <<"Correct : " <<check_extended_gcd(a, b, lehmer)<<std::endl;
+    std::cout <<"Correct : " <<check_extended_gcd(a, b, half)<<std::endl;
+    std::cout <<"Correct : " <<(half.gcd == lehmer.gcd && halfGcd == lehmer.gcd)<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
 
+    std::cout <<"For MOD_INVERSE:"<< std::endl;
+    BigInt m = pow(BigInt(2), 521) - BigInt(1);
+    a = BigInt::random(600, rng);
+    BigInt inv = mod_inverse(a, m);
+    std::cout <<"Correct : " <<(inv < m && inv * a % m == BigInt(1))<<std::endl;
+    std::cout <<"Correct : " <<throws<std::domain_error>([] { mod_inverse(BigInt(6), BigInt(15)); })<<std::endl;
+    std::cout <<"Correct : " <<throws<std::domain_error>([] { mod_inverse(BigInt(6), BigInt(0)); })<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
 }
-bool compare (std::string ans, std::string result){
-    return ans == result;
+
+void test_primes(){
+    std::cout <<"For IS_PROBABLE_PRIME:"<< std::endl;
+    BigInt mersenne127 = pow(BigInt(2), 127) - BigInt(1);
+    BigInt mersenne521 = pow(BigInt(2), 521) - BigInt(1);
+    bool primes = is_probable_prime(BigInt(2)) && is_probable_prime(BigInt(4294967291u))
+        && is_probable_prime(pow(BigInt(2), 61) - BigInt(1)) && is_probable_prime(mersenne127)
+        && is_probable_prime(mersenne521);
+    std::cout <<"Correct : " <<primes<<std::endl;
+    //3215031751 and 2^64 + 1 are strong pseudoprimes to base 2, the others Carmichael numbers
+    BigInt carmichael;
+    carmichael.setDec("1296001987165015643369032371289");
+    bool composites = !is_probable_prime(BigInt(1)) && !is_probable_prime(BigInt(561))
+        && !is_probable_prime(BigInt(3215031751u)) && !is_probable_prime(pow(BigInt(2), 64) + BigInt(1))
+        && !is_probable_prime(carmichael) && !is_probable_prime(mersenne127 * mersenne127)
+        && !is_probable_prime(mersenne127 * mersenne521);
+    std::cout <<"Correct : " <<composites<<std::endl;
+    std::mt19937_64 rng(24);
+    std::cout <<"Correct : " <<is_probable_prime(mersenne521, 4, rng)<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+
+    std::cout <<"For NEXT_PRIME:"<< std::endl;
+    BigInt ten20 = pow(BigInt(10), 20), ten50 = pow(BigInt(10), 50);
+    bool next = next_prime(BigInt(0)) == BigInt(2) && next_prime(BigInt(13)) == BigInt(17)
+        && next_prime(ten20) == ten20 + BigInt(39) && next_prime(pow(BigInt(2), 64)) == pow(BigInt(2), 64) + BigInt(13);
+    std::string out = (ten50 + BigInt(151)).getDec();
+    BigInt p = next_prime(ten50);
+    std::cout << "Expect: " << out<<std::endl;
+    std::cout << "Result: " << p.getDec() << std::endl;
+    std::cout <<"Correct : " <<compare(out, p.getDec())<<std::endl;
+    std::cout <<"Correct : " <<next<<std::endl;
+    //a gap of 1132, longer than the first sieve window
+    BigInt before(1693182318746371ull);
+    std::cout <<"Correct : " <<(next_prime(before) == before + BigInt(1132))<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+
+    std::cout <<"For RANDOM_PRIME:"<< std::endl;
+    bool sizes = true;
+    for (size_t bits : {2, 17, 32, 33, 64, 65, 200, 512}) {
+        BigInt q = random_prime(bits, rng);
+        sizes = sizes && q.bitLength() == bits && is_probable_prime(q);
+    }
+    std::cout <<"Correct : " <<sizes<<std::endl;
+    //the survivors of a window are tested on the pool, the first prime in order wins
+    std::mt19937_64 serialRng(7), parallelRng(7);
+    BigInt serial = random_prime(768, serialRng);
+    BigInt serialNext = next_prime(serial);
+    BigInt::parallelism().threads = 4;
+    BigInt parallel = random_prime(768, parallelRng);
+    BigInt parallelNext = next_prime(parallel);
+    BigInt::parallelism().threads = 1;
+    std::cout <<"Correct : " <<(serial == parallel && serialNext == parallelNext)<<std::endl;
+    std::cout <<"Correct : " <<throws<std::domain_error>([&] { random_prime(1, rng); })<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
 }
 
 int main(){
@@ -608,6 +722,25 @@ int main(){
     std::cout << "Result: " << num3.getBin() << std::endl;
     std::cout <<"Correct : " <<compare(out, num3.getBin())<<std::endl;
     std::cout <<"_________________________"<< std::endl;
+
+    test_hex_bin();
+    test_serialize();
+    test_decimal();
+    test_division();
+    test_residues();
+    test_montgomery();
+    test_barrett();
+    test_shifts();
+    test_parallel();
+    test_lazy();
+    test_batch();
+    test_fixed();
+    test_arena();
+    test_square();
+    test_kernels();
+    test_gcd();
+    test_roots();
+    test_primes();
     
     return 0;
 }
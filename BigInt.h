@@ -0,0 +1,5169 @@
+#ifndef BIGINT_H
+#define BIGINT_H
+
+#include <iostream>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include<iterator>
+#include <cstdint>
+#include <cstring>
+#include <utility>
+#include <stdexcept>
+#include <string_view>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <memory_resource>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <type_traits>
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+#if defined(__GNUC__) && defined(__x86_64__)
+#include <immintrin.h>
+#define BIGINT_X86_DISPATCH
+#endif
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+
+typedef uint64_t Limb;
+typedef unsigned __int128 DoubleLimb;
+
+//hot-path instrumentation. Built with -DBIGINT_INSTRUMENT, the BIGINT_COUNT_* hooks
+//record operator calls with their operand sizes, limb allocations, copies and moves,
+//and the time spent in each algorithm tier. Without it the hooks expand to nothing
+//and snapshot() stays all zero. Counters are relaxed atomics shared by all threads
+class BigIntStats {
+public:
+    enum Op {
+        Add, Sub, Mul, Square, DivMod, ModWord, And, Or, Xor, Not, Shl, Shr,
+        ParseHex, ParseBin, ParseDec, FormatHex, FormatBin, FormatDec, OP_COUNT
+    };
+    enum Tier {
+        SingleLimb, Schoolbook, Karatsuba, Toom3, Ntt, Unbalanced, KnuthD, BurnikelZiegler, TIER_COUNT
+    };
+    //bucket 0 counts empty operands, bucket k > 0 operands of [2^(k-1), 2^k) limbs
+    static const int SIZE_BUCKETS = 40;
+#ifdef BIGINT_INSTRUMENT
+    static const bool enabled = true;
+#else
+    static const bool enabled = false;
+#endif
+
+    struct Snapshot {
+        uint64_t calls[OP_COUNT] = {};
+        uint64_t sizes[OP_COUNT][SIZE_BUCKETS] = {};
+        uint64_t tierCalls[TIER_COUNT] = {};
+        uint64_t tierNanos[TIER_COUNT] = {};
+        uint64_t allocations = 0;
+        uint64_t reallocations = 0;
+        uint64_t limbsAllocated = 0;
+        uint64_t copies = 0;
+        uint64_t bytesCopied = 0;
+        uint64_t moves = 0;
+        uint64_t bytesMoved = 0;
+
+        std::string text() const {
+            std::string out = "op          calls  operand limbs: count\n";
+            for (int op = 0; op < OP_COUNT; ++op) {
+                if (calls[op] == 0)
+                    continue;
+                out += Pad(name(Op(op)), 12) + Pad(std::to_string(calls[op]), 7);
+                for (int k = 0; k < SIZE_BUCKETS; ++k) {
+                    if (sizes[op][k] != 0)
+                        out += " " + std::to_string(BucketStart(k)) + ":" + std::to_string(sizes[op][k]);
+                }
+                out += "\n";
+            }
+            out += "tier              calls  self ms\n";
+            for (int tier = 0; tier < TIER_COUNT; ++tier) {
+                if (tierCalls[tier] == 0)
+                    continue;
+                out += Pad(name(Tier(tier)), 18) + Pad(std::to_string(tierCalls[tier]), 7)
+                    + std::to_string(tierNanos[tier] / 1000000.0) + "\n";
+            }
+            out += "allocations " + std::to_string(allocations) + " (" + std::to_string(reallocations)
+                + " reallocations, " + std::to_string(limbsAllocated) + " limbs)\n";
+            out += "copies " + std::to_string(copies) + " (" + std::to_string(bytesCopied) + " bytes)\n";
+            out += "moves " + std::to_string(moves) + " (" + std::to_string(bytesMoved) + " bytes copied)\n";
+            return out;
+        }
+        //size buckets are keyed by their smallest limb count
+        std::string json() const {
+            std::string out = "{\n  \"ops\": {";
+            bool first = true;
+            for (int op = 0; op < OP_COUNT; ++op) {
+                if (calls[op] == 0)
+                    continue;
+                out += std::string(first ? "" : ",") + "\n    \"" + name(Op(op)) + "\": {\"calls\": "
+                    + std::to_string(calls[op]) + ", \"sizes\": {";
+                bool firstBucket = true;
+                for (int k = 0; k < SIZE_BUCKETS; ++k) {
+                    if (sizes[op][k] == 0)
+                        continue;
+                    out += std::string(firstBucket ? "" : ", ") + "\"" + std::to_string(BucketStart(k))
+                        + "\": " + std::to_string(sizes[op][k]);
+                    firstBucket = false;
+                }
+                out += "}}";
+                first = false;
+            }
+            out += "\n  },\n  \"tiers\": {";
+            first = true;
+            for (int tier = 0; tier < TIER_COUNT; ++tier) {
+                if (tierCalls[tier] == 0)
+                    continue;
+                out += std::string(first ? "" : ",") + "\n    \"" + name(Tier(tier)) + "\": {\"calls\": "
+                    + std::to_string(tierCalls[tier]) + ", \"self_ns\": " + std::to_string(tierNanos[tier]) + "}";
+                first = false;
+            }
+            out += "\n  },\n  \"allocations\": " + std::to_string(allocations)
+                + ",\n  \"reallocations\": " + std::to_string(reallocations)
+                + ",\n  \"limbs_allocated\": " + std::to_string(limbsAllocated)
+                + ",\n  \"copies\": " + std::to_string(copies)
+                + ",\n  \"bytes_copied\": " + std::to_string(bytesCopied)
+                + ",\n  \"moves\": " + std::to_string(moves)
+                + ",\n  \"bytes_moved\": " + std::to_string(bytesMoved) + "\n}\n";
+            return out;
+        }
+    };
+
+    static Snapshot snapshot() {
+        Counters& c = counters();
+        Snapshot s;
+        for (int op = 0; op < OP_COUNT; ++op) {
+            s.calls[op] = c.calls[op].load(std::memory_order_relaxed);
+            for (int k = 0; k < SIZE_BUCKETS; ++k)
+                s.sizes[op][k] = c.sizes[op][k].load(std::memory_order_relaxed);
+        }
+        for (int tier = 0; tier < TIER_COUNT; ++tier) {
+            s.tierCalls[tier] = c.tierCalls[tier].load(std::memory_order_relaxed);
+            s.tierNanos[tier] = c.tierNanos[tier].load(std::memory_order_relaxed);
+        }
+        s.allocations = c.allocations.load(std::memory_order_relaxed);
+        s.reallocations = c.reallocations.load(std::memory_order_relaxed);
+        s.limbsAllocated = c.limbsAllocated.load(std::memory_order_relaxed);
+        s.copies = c.copies.load(std::memory_order_relaxed);
+        s.bytesCopied = c.bytesCopied.load(std::memory_order_relaxed);
+        s.moves = c.moves.load(std::memory_order_relaxed);
+        s.bytesMoved = c.bytesMoved.load(std::memory_order_relaxed);
+        return s;
+    }
+    static void reset() {
+        Counters& c = counters();
+        for (int op = 0; op < OP_COUNT; ++op) {
+            c.calls[op].store(0, std::memory_order_relaxed);
+            for (int k = 0; k < SIZE_BUCKETS; ++k)
+                c.sizes[op][k].store(0, std::memory_order_relaxed);
+        }
+        for (int tier = 0; tier < TIER_COUNT; ++tier) {
+            c.tierCalls[tier].store(0, std::memory_order_relaxed);
+            c.tierNanos[tier].store(0, std::memory_order_relaxed);
+        }
+        for (std::atomic<uint64_t>* counter : {&c.allocations, &c.reallocations, &c.limbsAllocated,
+                                               &c.copies, &c.bytesCopied, &c.moves, &c.bytesMoved})
+            counter->store(0, std::memory_order_relaxed);
+    }
+
+    static const char* name(Op op) {
+        static const char* const names[OP_COUNT] = {
+            "add", "sub", "mul", "square", "divmod", "mod_word", "and", "or", "xor", "not", "shl", "shr",
+            "parse_hex", "parse_bin", "parse_dec", "format_hex", "format_bin", "format_dec"
+        };
+        return names[op];
+    }
+    static const char* name(Tier tier) {
+        static const char* const names[TIER_COUNT] = {
+            "single_limb", "schoolbook", "karatsuba", "toom3", "ntt", "unbalanced", "knuth_d", "burnikel_ziegler"
+        };
+        return names[tier];
+    }
+
+    //the hooks behind the BIGINT_COUNT_* macros
+    static void CountAllocation(size_t limbs, bool reallocation) {
+        Counters& c = counters();
+        c.allocations.fetch_add(1, std::memory_order_relaxed);
+        c.limbsAllocated.fetch_add(limbs, std::memory_order_relaxed);
+        if (reallocation)
+            c.reallocations.fetch_add(1, std::memory_order_relaxed);
+    }
+    static void CountCopy(size_t bytes) {
+        counters().copies.fetch_add(1, std::memory_order_relaxed);
+        counters().bytesCopied.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    static void CountMove(size_t bytes) {
+        counters().moves.fetch_add(1, std::memory_order_relaxed);
+        counters().bytesMoved.fetch_add(bytes, std::memory_order_relaxed);
+    }
+    //only the outermost operator on a thread is counted, so the operators BigInt uses
+    //internally (Toom-3 sums, division steps) don't show up as traffic
+    class OpScope {
+    public:
+        OpScope(Op op, size_t limbs) {
+            if (opDepth++ == 0) {
+                counters().calls[op].fetch_add(1, std::memory_order_relaxed);
+                counters().sizes[op][Bucket(limbs)].fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+        ~OpScope() {
+            --opDepth;
+        }
+        OpScope(const OpScope&) = delete;
+        OpScope& operator=(const OpScope&) = delete;
+    };
+    //self time of a tier: time spent in the tiers it calls on the same thread is
+    //booked to those. Tasks forked to the thread pool count on their own thread
+    class TierScope {
+    public:
+        explicit TierScope(Tier tier) : tier(tier), start(std::chrono::steady_clock::now()), outerNested(nestedNanos) {
+            nestedNanos = 0;
+            counters().tierCalls[tier].fetch_add(1, std::memory_order_relaxed);
+        }
+        ~TierScope() {
+            uint64_t elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now() - start).count();
+            counters().tierNanos[tier].fetch_add(elapsed - std::min(elapsed, nestedNanos), std::memory_order_relaxed);
+            nestedNanos = outerNested + elapsed;
+        }
+        TierScope(const TierScope&) = delete;
+        TierScope& operator=(const TierScope&) = delete;
+
+    private:
+        Tier tier;
+        std::chrono::steady_clock::time_point start;
+        uint64_t outerNested;
+    };
+
+private:
+    struct Counters {
+        std::atomic<uint64_t> calls[OP_COUNT] = {};
+        std::atomic<uint64_t> sizes[OP_COUNT][SIZE_BUCKETS] = {};
+        std::atomic<uint64_t> tierCalls[TIER_COUNT] = {};
+        std::atomic<uint64_t> tierNanos[TIER_COUNT] = {};
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> reallocations{0};
+        std::atomic<uint64_t> limbsAllocated{0};
+        std::atomic<uint64_t> copies{0};
+        std::atomic<uint64_t> bytesCopied{0};
+        std::atomic<uint64_t> moves{0};
+        std::atomic<uint64_t> bytesMoved{0};
+    };
+    static Counters& counters() {
+        static Counters instance;
+        return instance;
+    }
+    static int Bucket(size_t limbs) {
+        int k = limbs == 0 ? 0 : 64 - __builtin_clzll(limbs);
+        return std::min(k, SIZE_BUCKETS - 1);
+    }
+    static uint64_t BucketStart(int k) {
+        return k == 0 ? 0 : uint64_t(1) << (k - 1);
+    }
+    static std::string Pad(std::string s, size_t width) {
+        if (s.size() < width)
+            s.resize(width, ' ');
+        return s;
+    }
+    static inline thread_local int opDepth = 0;
+    static inline thread_local uint64_t nestedNanos = 0;
+};
+
+#ifdef BIGINT_INSTRUMENT
+#define BIGINT_CONCAT_IMPL(a, b) a##b
+#define BIGINT_CONCAT(a, b) BIGINT_CONCAT_IMPL(a, b)
+#define BIGINT_COUNT_OP(op, limbs) BigIntStats::OpScope BIGINT_CONCAT(bigintOpScope, __LINE__)(BigIntStats::op, limbs)
+#define BIGINT_COUNT_TIER(tier) BigIntStats::TierScope BIGINT_CONCAT(bigintTierScope, __LINE__)(BigIntStats::tier)
+#define BIGINT_COUNT_ALLOCATION(limbs, reallocation) BigIntStats::CountAllocation(limbs, reallocation)
+#define BIGINT_COUNT_COPY(bytes) BigIntStats::CountCopy(bytes)
+#define BIGINT_COUNT_MOVE(bytes) BigIntStats::CountMove(bytes)
+#else
+#define BIGINT_COUNT_OP(op, limbs)
+#define BIGINT_COUNT_TIER(tier)
+#define BIGINT_COUNT_ALLOCATION(limbs, reallocation)
+#define BIGINT_COUNT_COPY(bytes)
+#define BIGINT_COUNT_MOVE(bytes)
+#endif
+
+//contiguous limb storage, values up to 512 bits live inline without heap allocation.
+//Heap buffers come from a std::pmr::memory_resource when one is given, otherwise
+//from new[]. Like the pmr containers, a copy uses the default (new[]) and a move
+//keeps the resource of its source
+class LimbVector {
+public:
+    static const size_t INLINE_LIMBS = 8;
+
+    LimbVector() : ptr(local), len(0), cap(INLINE_LIMBS), resource(nullptr) {
+    }
+    explicit LimbVector(std::pmr::memory_resource* resource) : ptr(local), len(0), cap(INLINE_LIMBS), resource(resource) {
+    }
+    LimbVector(const LimbVector& other) : ptr(local), len(0), cap(INLINE_LIMBS), resource(nullptr) {
+        BIGINT_COUNT_COPY(other.len * sizeof(Limb));
+        assign(other.begin(), other.end());
+    }
+    //heap buffers are stolen, inline ones are at most INLINE_LIMBS words to copy
+    LimbVector(LimbVector&& other) noexcept : ptr(local), len(0), cap(INLINE_LIMBS), resource(other.resource) {
+        take(other);
+    }
+    ~LimbVector() {
+        release();
+    }
+    LimbVector& operator=(const LimbVector& other) {
+        if (this != &other) {
+            BIGINT_COUNT_COPY(other.len * sizeof(Limb));
+            assign(other.begin(), other.end());
+        }
+        return *this;
+    }
+    //a buffer from another resource cannot be adopted and is copied instead, which
+    //allocates; that is why this is not noexcept (the move constructor is)
+    LimbVector& operator=(LimbVector&& other) {
+        if (this == &other) {
+            return *this;
+        }
+        if (resource != other.resource) {
+            BIGINT_COUNT_MOVE(other.len * sizeof(Limb));
+            assign(other.begin(), other.end());
+            return *this;
+        }
+        release();
+        ptr = local;
+        cap = INLINE_LIMBS;
+        take(other);
+        return *this;
+    }
+
+    std::pmr::memory_resource* get_resource() const { return resource; }
+    size_t size() const { return len; }
+    size_t capacity() const { return cap; }
+    bool empty() const { return len == 0; }
+    Limb* data() { return ptr; }
+    const Limb* data() const { return ptr; }
+    Limb* begin() { return ptr; }
+    Limb* end() { return ptr + len; }
+    const Limb* begin() const { return ptr; }
+    const Limb* end() const { return ptr + len; }
+    Limb& operator[](size_t i) { return ptr[i]; }
+    const Limb& operator[](size_t i) const { return ptr[i]; }
+    Limb& back() { return ptr[len - 1]; }
+    const Limb& back() const { return ptr[len - 1]; }
+
+    void clear() {
+        len = 0;
+    }
+    void reserve(size_t n) {
+        if (n > cap) {
+            grow(n);
+        }
+    }
+    void resize(size_t n, Limb value = 0) {
+        reserve(n);
+        for (size_t i = len; i < n; ++i) {
+            ptr[i] = value;
+        }
+        len = n;
+    }
+    //for buffers that are overwritten right away
+    void resize_uninitialized(size_t n) {
+        reserve(n);
+        len = n;
+    }
+    void push_back(Limb value) {
+        if (len == cap) {
+            grow(cap * 2);
+        }
+        ptr[len++] = value;
+    }
+    void pop_back() {
+        --len;
+    }
+    void assign(const Limb* first, const Limb* last) {
+        size_t n = last - first;
+        if (n > cap) {
+            BIGINT_COUNT_ALLOCATION(n, false);
+            Limb* fresh = allocate(n);
+            release();
+            ptr = fresh;
+            cap = n;
+        }
+        std::memmove(ptr, first, n * sizeof(Limb));
+        len = n;
+    }
+    //insert count copies of value before the lowest limb
+    void insert_front(size_t count, Limb value) {
+        reserve(len + count);
+        std::memmove(ptr + count, ptr, len * sizeof(Limb));
+        for (size_t i = 0; i < count; ++i) {
+            ptr[i] = value;
+        }
+        len += count;
+    }
+    //drop the count lowest limbs
+    void erase_front(size_t count) {
+        if (count >= len) {
+            len = 0;
+            return;
+        }
+        std::memmove(ptr, ptr + count, (len - count) * sizeof(Limb));
+        len -= count;
+    }
+
+private:
+    void take(LimbVector& other) {
+        if (other.ptr == other.local) {
+            BIGINT_COUNT_MOVE(other.len * sizeof(Limb));
+            std::memcpy(local, other.local, other.len * sizeof(Limb));
+        }
+        else {
+            BIGINT_COUNT_MOVE(0);
+            ptr = other.ptr;
+            cap = other.cap;
+            other.ptr = other.local;
+            other.cap = INLINE_LIMBS;
+        }
+        len = other.len;
+        other.len = 0;
+    }
+    void grow(size_t n) {
+        n = std::max(n, cap * 2);
+        BIGINT_COUNT_ALLOCATION(n, len != 0);
+        Limb* fresh = allocate(n);
+        std::memcpy(fresh, ptr, len * sizeof(Limb));
+        release();
+        ptr = fresh;
+        cap = n;
+    }
+    Limb* allocate(size_t n) {
+        if (resource == nullptr) {
+            return new Limb[n];
+        }
+        return static_cast<Limb*>(resource->allocate(n * sizeof(Limb), alignof(Limb)));
+    }
+    void release() {
+        if (ptr == local) {
+            return;
+        }
+        if (resource == nullptr) {
+            delete[] ptr;
+        }
+        else {
+            resource->deallocate(ptr, cap * sizeof(Limb), alignof(Limb));
+        }
+    }
+
+    Limb* ptr;
+    size_t len;
+    size_t cap;
+    std::pmr::memory_resource* resource;
+    Limb local[INLINE_LIMBS];
+};
+
+
+//fork-join pool with one task deque per thread. A thread pops its own newest task
+//and steals the oldest one of another thread when it runs dry; a thread waiting on
+//a group keeps running tasks instead of blocking, so nested forks cannot deadlock.
+//With nothing left to run it sleeps until a task is queued or its group is done
+class ThreadPool {
+public:
+    //tasks forked together and waited for together; the first exception is rethrown by wait
+    class TaskGroup {
+    public:
+        TaskGroup() : pending(0), lease(NO_LEASE), ownsLease(false), outerOwner(nullptr), outerIndex(0) {
+        }
+    private:
+        friend class ThreadPool;
+        std::atomic<size_t> pending;
+        std::mutex errorLock;
+        std::exception_ptr error;
+        //the queue a thread from outside the pool took to fork this group, and the
+        //queue the thread had before
+        size_t lease;
+        bool ownsLease;
+        const ThreadPool* outerOwner;
+        size_t outerIndex;
+    };
+
+    //threads - 1 workers, the thread calling wait is the last one. A thread from outside
+    //the pool leases a queue of its own for as long as it has a group in flight; there
+    //are threads of those, and callers beyond that share them
+    explicit ThreadPool(unsigned threads)
+        : threads(std::max(threads, 1u)), queues(2 * this->threads - 1), nextShared(0), queued(0), stopping(false) {
+        for (size_t i = queues.size(); i-- > this->threads - 1;)
+            spareQueues.push_back(i);
+        for (unsigned i = 0; i + 1 < this->threads; ++i) {
+            workers.emplace_back([this, i] { WorkerLoop(i); });
+        }
+    }
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            stopping = true;
+        }
+        wake.notify_all();
+        for (std::thread& worker : workers)
+            worker.join();
+    }
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    size_t size() const { return threads; }
+
+    void run(TaskGroup& group, std::function<void()> task) {
+        if (owner != this)
+            Lease(group);
+        ++group.pending;
+        Queue& queue = queues[index];
+        {
+            std::lock_guard<std::mutex> guard(queue.lock);
+            queue.tasks.push_back(Task{std::move(task), &group});
+        }
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            ++queued;
+        }
+        wake.notify_one();
+    }
+    void wait(TaskGroup& group) {
+        size_t self = owner == this ? index : threads - 1;
+        while (group.pending.load() != 0) {
+            if (RunOne(self))
+                continue;
+            std::unique_lock<std::mutex> guard(sleepLock);
+            wake.wait(guard, [&] { return group.pending.load() == 0 || queued != 0; });
+        }
+        if (group.lease != NO_LEASE)
+            Release(group);
+        if (group.error)
+            std::rethrow_exception(group.error);
+    }
+
+    //one pool per thread count, created on first use and kept until exit, so that
+    //operations still running on a pool are unaffected when parallelism() changes
+    static ThreadPool& shared(unsigned threads) {
+        static std::mutex lock;
+        static std::map<unsigned, std::unique_ptr<ThreadPool>> pools;
+        std::lock_guard<std::mutex> guard(lock);
+        std::unique_ptr<ThreadPool>& pool = pools[threads];
+        if (!pool)
+            pool.reset(new ThreadPool(threads));
+        return *pool;
+    }
+
+private:
+    static constexpr size_t NO_LEASE = SIZE_MAX;
+
+    struct Task {
+        std::function<void()> fn;
+        TaskGroup* group;
+    };
+    struct Queue {
+        std::mutex lock;
+        std::deque<Task> tasks;
+    };
+
+    //makes the calling thread, which is not one of this pool's, the owner of a spare queue
+    void Lease(TaskGroup& group) {
+        std::lock_guard<std::mutex> guard(leaseLock);
+        group.outerOwner = owner;
+        group.outerIndex = index;
+        group.ownsLease = !spareQueues.empty();
+        if (group.ownsLease) {
+            group.lease = spareQueues.back();
+            spareQueues.pop_back();
+        }
+        else {
+            group.lease = threads - 1 + nextShared++ % threads;
+        }
+        owner = this;
+        index = group.lease;
+    }
+    void Release(TaskGroup& group) {
+        owner = group.outerOwner;
+        index = group.outerIndex;
+        if (group.ownsLease) {
+            std::lock_guard<std::mutex> guard(leaseLock);
+            spareQueues.push_back(group.lease);
+        }
+    }
+    bool RunOne(size_t self) {
+        Task task;
+        bool found = false;
+        for (size_t k = 0; k < queues.size() && !found; ++k) {
+            Queue& queue = queues[(self + k) % queues.size()];
+            std::lock_guard<std::mutex> guard(queue.lock);
+            if (!queue.tasks.empty()) {
+                if (k == 0) {
+                    task = std::move(queue.tasks.back());
+                    queue.tasks.pop_back();
+                }
+                else {
+                    task = std::move(queue.tasks.front());
+                    queue.tasks.pop_front();
+                }
+                found = true;
+            }
+        }
+        if (!found)
+            return false;
+        {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            --queued;
+        }
+        try {
+            task.fn();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> guard(task.group->errorLock);
+            if (!task.group->error)
+                task.group->error = std::current_exception();
+        }
+        //the waiter may destroy the group as soon as pending reaches zero
+        if (--task.group->pending == 0) {
+            std::lock_guard<std::mutex> guard(sleepLock);
+            wake.notify_all();
+        }
+        return true;
+    }
+    void WorkerLoop(size_t self) {
+        owner = this;
+        index = self;
+        for (;;) {
+            if (RunOne(self))
+                continue;
+            std::unique_lock<std::mutex> guard(sleepLock);
+            wake.wait(guard, [this] { return stopping || queued != 0; });
+            if (stopping)
+                return;
+        }
+    }
+
+    static thread_local const ThreadPool* owner;
+    static thread_local size_t index;
+
+    size_t threads;
+    //the workers' queues, then the spare ones leased to outside threads
+    std::vector<Queue> queues;
+    std::vector<std::thread> workers;
+    std::mutex leaseLock;
+    std::vector<size_t> spareQueues;
+    size_t nextShared;
+    std::mutex sleepLock;
+    std::condition_variable wake;
+    size_t queued;
+    bool stopping;
+};
+
+inline thread_local const ThreadPool* ThreadPool::owner = nullptr;
+inline thread_local size_t ThreadPool::index = 0;
+
+//bump allocator for multiplication scratch. Allocations are released in reverse
+//order when their Frame ends; the buffer only grows while nothing is allocated, so a
+//caller reserves the whole scratch size (BigInt::multiplyScratch) up front
+class LimbArena {
+public:
+    LimbArena() : capacity(0), used(0) {
+    }
+    explicit LimbArena(size_t limbs) : LimbArena() {
+        reserve(limbs);
+    }
+    LimbArena(const LimbArena&) = delete;
+    LimbArena& operator=(const LimbArena&) = delete;
+
+    //false when the arena is in use and too small
+    bool reserve(size_t limbs) {
+        if (limbs <= capacity - used)
+            return true;
+        if (used != 0)
+            return false;
+        BIGINT_COUNT_ALLOCATION(limbs, false);
+        buffer.reset(new Limb[limbs]);
+        capacity = limbs;
+        return true;
+    }
+    Limb* allocate(size_t limbs) {
+        if (limbs > capacity - used) {
+            throw std::length_error("LimbArena: scratch size was not reserved");
+        }
+        Limb* block = buffer.get() + used;
+        used += limbs;
+        return block;
+    }
+
+    //everything allocated during the lifetime of a Frame is freed at its end
+    class Frame {
+    public:
+        explicit Frame(LimbArena& arena) : arena(arena), mark(arena.used) {
+        }
+        ~Frame() {
+            arena.used = mark;
+        }
+        Frame(const Frame&) = delete;
+        Frame& operator=(const Frame&) = delete;
+    private:
+        LimbArena& arena;
+        size_t mark;
+    };
+
+private:
+    std::unique_ptr<Limb[]> buffer;
+    size_t capacity;
+    size_t used;
+};
+
+//binary form of a BigInt: "BIGI", uint32 limb width in bytes, uint64 limb count,
+//then the limbs least significant first, all little-endian
+struct SerializedHeader {
+    static constexpr size_t SIZE = 16;
+    static constexpr char MAGIC[4] = {'B', 'I', 'G', 'I'};
+
+    uint32_t limbBytes;
+    uint64_t limbCount;
+
+    static uint64_t LoadLE(const char* bytes, int width) {
+        uint64_t value = 0;
+        for (int i = width; i-- > 0;)
+            value = (value << 8) | static_cast<uint8_t>(bytes[i]);
+        return value;
+    }
+    static void StoreLE(char* bytes, uint64_t value, int width) {
+        for (int i = 0; i < width; ++i, value >>= 8)
+            bytes[i] = static_cast<char>(value & 0xFF);
+    }
+
+    void Write(char* out) const {
+        std::memcpy(out, MAGIC, 4);
+        StoreLE(out + 4, limbBytes, 4);
+        StoreLE(out + 8, limbCount, 8);
+    }
+    //checks the magic and the limb width of the first SIZE bytes
+    static SerializedHeader Parse(const char* bytes) {
+        if (std::memcmp(bytes, MAGIC, 4) != 0) {
+            throw std::invalid_argument("BigInt: not a serialized BigInt");
+        }
+        SerializedHeader header;
+        header.limbBytes = static_cast<uint32_t>(LoadLE(bytes + 4, 4));
+        header.limbCount = LoadLE(bytes + 8, 8);
+        if (header.limbBytes != 4 && header.limbBytes != 8) {
+            throw std::invalid_argument("BigInt: unsupported serialized limb width");
+        }
+        return header;
+    }
+    //also checks that the limbs fit in length bytes
+    static SerializedHeader Read(const char* bytes, size_t length) {
+        if (length < SIZE) {
+            throw std::length_error("BigInt: serialized data is truncated");
+        }
+        SerializedHeader header = Parse(bytes);
+        if (header.limbCount > (length - SIZE) / header.limbBytes) {
+            throw std::length_error("BigInt: serialized data is truncated");
+        }
+        return header;
+    }
+};
+
+class BigInt;
+template<size_t N> class BigIntExpr;
+
+//read-only, non-owning view of normalized little-endian limbs: a BigInt, any external
+//limb buffer or a memory-mapped file. BigInt operators take their right operand as a
+//view, so all of these (and plain integers) can be used without copying.
+class BigIntView {
+public:
+    BigIntView() : ptr(&single), len(0), single(0) {
+    }
+    BigIntView(Limb value) : ptr(&single), len(1), single(value) {
+    }
+    BigIntView(const BigInt& number);
+    //leading zero limbs are not part of the view
+    BigIntView(const Limb* limbs, size_t count) : ptr(limbs), len(count), single(0) {
+        while (len > 1 && ptr[len - 1] == 0)
+            --len;
+    }
+    BigIntView(const BigIntView& other) : ptr(other.ptr), len(other.len), single(other.single) {
+        if (other.ptr == &other.single)
+            ptr = &single;
+    }
+    BigIntView& operator=(const BigIntView& other) {
+        single = other.single;
+        len = other.len;
+        ptr = other.ptr == &other.single ? &single : other.ptr;
+        return *this;
+    }
+
+    size_t size() const { return len; }
+    bool empty() const { return len == 0; }
+    const Limb* data() const { return ptr; }
+    const Limb* begin() const { return ptr; }
+    const Limb* end() const { return ptr + len; }
+    Limb operator[](size_t i) const { return ptr[i]; }
+    Limb back() const { return ptr[len - 1]; }
+    bool isZero() const { return len == 0 || (len == 1 && ptr[0] == 0); }
+    //zero-copy view of serialize() output, e.g. a memory-mapped file; needs 64-bit
+    //limbs, a little-endian host and 8-byte aligned bytes, otherwise use deserialize
+    static BigIntView fromSerialized(const char* bytes, size_t length) {
+        SerializedHeader header = SerializedHeader::Read(bytes, length);
+        const char* payload = bytes + SerializedHeader::SIZE;
+        if (header.limbBytes != sizeof(Limb) || __BYTE_ORDER__ != __ORDER_LITTLE_ENDIAN__ ||
+            reinterpret_cast<uintptr_t>(payload) % alignof(Limb) != 0) {
+            throw std::invalid_argument("BigIntView::fromSerialized: data cannot be viewed in place");
+        }
+        return BigIntView(reinterpret_cast<const Limb*>(payload), header.limbCount);
+    }
+    //limbs [from, from + count) as a view
+    BigIntView slice(size_t from, size_t count) const {
+        if (from >= len)
+            return BigIntView();
+        return BigIntView(ptr + from, std::min(count, len - from));
+    }
+
+private:
+    const Limb* ptr;
+    size_t len;
+    Limb single;
+};
+
+//quotient and remainder in one pass, defined after BigInt
+std::pair<BigInt, BigInt> divmod(BigIntView a, BigIntView b);
+
+class BigInt {
+public:
+    static const int LIMB_BITS = 64;
+
+    BigInt() {
+    }
+    BigInt(Limb num) {
+        blocks.push_back(num);
+    }
+    //heap limbs of this number come from resource; results of the binary operators
+    //are new numbers on the default heap, compound assignments keep the resource
+    explicit BigInt(std::pmr::memory_resource& resource) : blocks(&resource) {
+    }
+    BigInt(Limb num, std::pmr::memory_resource& resource) : blocks(&resource) {
+        blocks.push_back(num);
+    }
+    std::pmr::memory_resource* memoryResource() const {
+        return blocks.get_resource();
+    }
+    //copy const
+    BigInt(const BigInt& other){
+        this->blocks = other.blocks;
+    }
+    //move const
+    BigInt(BigInt&& other) noexcept : blocks(std::move(other.blocks)) {
+    }
+    //evaluates a lazy sum, see BigIntExpr
+    template<size_t N>
+    BigInt(const BigIntExpr<N>& expr) {
+        expr.evalInto(*this);
+    }
+    //copies the limbs of a view
+    explicit BigInt(BigIntView other) {
+        blocks.assign(other.begin(), other.end());
+        if (blocks.empty())
+            blocks.push_back(0);
+    }
+    BigIntView view() const {
+        return BigIntView(blocks.data(), blocks.size());
+    }
+
+
+    //hex and binary text is converted a whole limb at a time (SSE2 where available)
+    //straight into the limbs or into a presized buffer
+    void setHex(std::string_view hexStr) {
+        size_t limbs = (hexStr.size() + 15) / 16;
+        BIGINT_COUNT_OP(ParseHex, limbs);
+        blocks.resize(std::max<size_t>(limbs, 1));
+        blocks[0] = 0;
+        size_t end = hexStr.size();
+        for (size_t i = 0; i < limbs; ++i) {
+            size_t start = end >= 16 ? end - 16 : 0;
+            blocks[i] = ParseHexLimb(hexStr.data() + start, end - start);
+            end = start;
+        }
+        delete_empty_blocks();
+    }
+    //chars written by getHex: whole 32-bit words, as with the original 32-bit blocks
+    size_t hexLength() const {
+        if (blocks.empty())
+            return 0;
+        return blocks.size() * 16 - ((blocks.back() >> 32) == 0 ? 8 : 0);
+    }
+    //writes hexLength() chars (no terminating zero), returns that count
+    size_t getHex(char* out, size_t capacity) const {
+        BIGINT_COUNT_OP(FormatHex, blocks.size());
+        size_t len = hexLength();
+        if (capacity < len) {
+            throw std::length_error("BigInt::getHex: buffer too small");
+        }
+        char* pos = out;
+        for (size_t i = blocks.size(); i-- > 0;) {
+            if (i == blocks.size() - 1 && (blocks[i] >> 32) == 0) {
+                char word[16];
+                FormatHexLimb(blocks[i], word);
+                std::memcpy(pos, word + 8, 8);
+                pos += 8;
+            }
+            else {
+                FormatHexLimb(blocks[i], pos);
+                pos += 16;
+            }
+        }
+        return len;
+    }
+    std::string getHex() const {
+        std::string hexStr(hexLength(), '0');
+        getHex(&hexStr[0], hexStr.size());
+        return hexStr;
+    }
+    void setBin(std::string_view binStr) {
+        size_t limbs = (binStr.size() + 63) / 64;
+        BIGINT_COUNT_OP(ParseBin, limbs);
+        blocks.resize(std::max<size_t>(limbs, 1));
+        blocks[0] = 0;
+        size_t end = binStr.size();
+        for (size_t i = 0; i < limbs; ++i) {
+            size_t start = end >= 64 ? end - 64 : 0;
+            blocks[i] = ParseBinLimb(binStr.data() + start, end - start);
+            end = start;
+        }
+        delete_empty_blocks();
+    }
+    size_t binLength() const {
+        return hexLength() * 4;
+    }
+    size_t getBin(char* out, size_t capacity) const {
+        BIGINT_COUNT_OP(FormatBin, blocks.size());
+        size_t len = binLength();
+        if (capacity < len) {
+            throw std::length_error("BigInt::getBin: buffer too small");
+        }
+        char* pos = out;
+        for (size_t i = blocks.size(); i-- > 0;) {
+            int bytes = (i == blocks.size() - 1 && (blocks[i] >> 32) == 0) ? 4 : 8;
+            for (int byte = bytes - 1; byte >= 0; --byte) {
+                FormatBinByte(static_cast<uint8_t>(blocks[i] >> (8 * byte)), pos);
+                pos += 8;
+            }
+        }
+        return len;
+    }
+    std::string getBin() const {
+        std::string binStr(binLength(), '0');
+        getBin(&binStr[0], binStr.size());
+        return binStr;
+    }
+    //decimal strings are split around cached powers 10^(19 * 2^k), so both
+    //directions cost a few multiplications/divisions instead of O(n^2)
+    void setDec(const std::string& decStr) {
+        BIGINT_COUNT_OP(ParseDec, (decStr.size() + 18) / 19);
+        if (decStr.empty()) {
+            throw std::invalid_argument("BigInt::setDec: empty string");
+        }
+        for (char c : decStr) {
+            if (c < '0' || c > '9')
+                throw std::invalid_argument("BigInt::setDec: not a decimal digit");
+        }
+        *this = ParseDec(decStr.data(), decStr.size());
+    }
+    std::string getDec() const {
+        BIGINT_COUNT_OP(FormatDec, blocks.size());
+        if (isZero()) {
+            return "0";
+        }
+        //bits * log10(2), rounded up
+        size_t width = static_cast<size_t>(static_cast<DoubleLimb>(bitLength()) * 1292913987u >> 32) + 2;
+        std::string decStr(width, '0');
+        FormatDec(*this, &decStr[0], width);
+        size_t first = decStr.find_first_not_of('0');
+        return decStr.substr(first);
+    }
+    //compact binary form, see SerializedHeader
+    size_t serializedSize() const {
+        return SerializedHeader::SIZE + std::max<size_t>(blocks.size(), 1) * sizeof(Limb);
+    }
+    size_t serialize(char* out) const {
+        BigIntView number = view();
+        if (number.empty())
+            number = BigIntView(0);
+        SerializedHeader header{sizeof(Limb), number.size()};
+        header.Write(out);
+        char* pos = out + SerializedHeader::SIZE;
+        if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) {
+            std::memcpy(pos, number.data(), number.size() * sizeof(Limb));
+        }
+        else {
+            for (size_t i = 0; i < number.size(); ++i)
+                SerializedHeader::StoreLE(pos + i * sizeof(Limb), number[i], sizeof(Limb));
+        }
+        return serializedSize();
+    }
+    void serialize(std::ostream& out) const {
+        std::string bytes(serializedSize(), '\0');
+        serialize(&bytes[0]);
+        out.write(bytes.data(), bytes.size());
+    }
+    //accepts 32-bit limbs as well; throws on a bad header or truncated data
+    static BigInt deserialize(const char* bytes, size_t length) {
+        SerializedHeader header = SerializedHeader::Read(bytes, length);
+        const char* pos = bytes + SerializedHeader::SIZE;
+        BigInt result;
+        if (header.limbBytes == sizeof(Limb)) {
+            result.blocks.resize(header.limbCount);
+            if (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) {
+                std::memcpy(result.blocks.data(), pos, header.limbCount * sizeof(Limb));
+            }
+            else {
+                for (size_t i = 0; i < header.limbCount; ++i)
+                    result.blocks[i] = SerializedHeader::LoadLE(pos + i * sizeof(Limb), sizeof(Limb));
+            }
+        }
+        else {
+            result.blocks.resize((header.limbCount + 1) / 2, 0);
+            for (size_t i = 0; i < header.limbCount; ++i)
+                result.blocks[i / 2] |= SerializedHeader::LoadLE(pos + i * 4, 4) << (i % 2 * 32);
+        }
+        if (result.blocks.empty())
+            result.blocks.push_back(0);
+        result.delete_empty_blocks();
+        return result;
+    }
+    static BigInt deserialize(std::istream& in) {
+        char header[SerializedHeader::SIZE];
+        if (!in.read(header, sizeof(header))) {
+            throw std::length_error("BigInt::deserialize: stream ended in the header");
+        }
+        SerializedHeader parsed = SerializedHeader::Parse(header);
+        if (parsed.limbCount > SIZE_MAX / parsed.limbBytes - sizeof(header)) {
+            throw std::length_error("BigInt::deserialize: limb count too large");
+        }
+        size_t payload = parsed.limbCount * parsed.limbBytes;
+        std::string bytes(header, sizeof(header));
+        bytes.resize(sizeof(header) + payload);
+        if (!in.read(&bytes[sizeof(header)], payload)) {
+            throw std::length_error("BigInt::deserialize: stream ended in the limbs");
+        }
+        return deserialize(bytes.data(), bytes.size());
+    }
+    //bits operations
+    
+    //INV
+    BigInt operator~() const {
+        BIGINT_COUNT_OP(Not, blocks.size());
+        BigInt result;
+        if (isZero()) {
+            result.blocks.push_back(1);
+            return result;
+        }
+        result.blocks.resize_uninitialized(blocks.size());
+        BitwiseLimbs(BitOp::Not, result.blocks.data(), blocks.data(), nullptr, blocks.size() - 1);
+        result.blocks.back() = blocks.back();
+        result._INV_for_last_block();
+        result.delete_empty_blocks();
+        return result;
+    }
+    //xor
+    BigInt& operator^= (BigIntView other){
+        BIGINT_COUNT_OP(Xor, std::max(blocks.size(), other.size()));
+        return BitwiseInPlace(BitOp::Xor, other);
+    }
+    BigInt operator^ (BigIntView other) const& {
+        BIGINT_COUNT_OP(Xor, std::max(blocks.size(), other.size()));
+        return Bitwise(BitOp::Xor, view(), other);
+    }
+    BigInt operator^ (BigIntView other) && {
+        *this ^= other;
+        return std::move(*this);
+    }
+
+    //or
+    BigInt& operator|= (BigIntView other){
+        BIGINT_COUNT_OP(Or, std::max(blocks.size(), other.size()));
+        return BitwiseInPlace(BitOp::Or, other);
+    }
+    BigInt operator| (BigIntView other) const& {
+        BIGINT_COUNT_OP(Or, std::max(blocks.size(), other.size()));
+        return Bitwise(BitOp::Or, view(), other);
+    }
+    BigInt operator| (BigIntView other) && {
+        *this |= other;
+        return std::move(*this);
+    }
+
+    //and
+    BigInt& operator&= (BigIntView other){
+        BIGINT_COUNT_OP(And, std::max(blocks.size(), other.size()));
+        return BitwiseInPlace(BitOp::And, other);
+    }
+    BigInt operator& (BigIntView other) const& {
+        BIGINT_COUNT_OP(And, std::max(blocks.size(), other.size()));
+        return Bitwise(BitOp::And, view(), other);
+    }
+    BigInt operator& (BigIntView other) && {
+        *this &= other;
+        return std::move(*this);
+    }
+    //shift left
+    BigInt& operator<<= (size_t n){
+        BIGINT_COUNT_OP(Shl, blocks.size());
+        if (n == 0 || isZero()) {
+            return *this;
+        }
+        size_t length = blocks.size();
+        size_t shifted = ShiftedLeftSize(view(), n);
+        blocks.resize_uninitialized(shifted);
+        ShiftLeftLimbs(blocks.data(), shifted, blocks.data(), length, n);
+        return *this;
+    }
+    BigInt operator<< (size_t n) const& {
+        BIGINT_COUNT_OP(Shl, blocks.size());
+        if (n == 0 || isZero()) {
+            return *this;
+        }
+        BigInt result;
+        size_t shifted = ShiftedLeftSize(view(), n);
+        result.blocks.resize_uninitialized(shifted);
+        ShiftLeftLimbs(result.blocks.data(), shifted, blocks.data(), blocks.size(), n);
+        return result;
+    }
+    BigInt operator<< (size_t n) && {
+        *this <<= n;
+        return std::move(*this);
+    }
+    
+    //shift right
+    BigInt& operator>>= (size_t n){
+        BIGINT_COUNT_OP(Shr, blocks.size());
+        if (n == 0 || blocks.empty()) {
+            return *this;
+        }
+        size_t shifted = ShiftedRightSize(view(), n);
+        ShiftRightLimbs(blocks.data(), shifted, blocks.data(), blocks.size(), n);
+        blocks.resize(shifted);
+        return *this;
+    }
+    BigInt operator>> (size_t n) const& {
+        BIGINT_COUNT_OP(Shr, blocks.size());
+        if (n == 0 || blocks.empty()) {
+            return *this;
+        }
+        BigInt result;
+        size_t shifted = ShiftedRightSize(view(), n);
+        result.blocks.resize_uninitialized(shifted);
+        ShiftRightLimbs(result.blocks.data(), shifted, blocks.data(), blocks.size(), n);
+        return result;
+    }
+    BigInt operator>> (size_t n) && {
+        *this >>= n;
+        return std::move(*this);
+    }
+
+    //arifmetical operations
+    //add
+    BigInt& operator+= (BigIntView other){
+        BIGINT_COUNT_OP(Add, std::max(blocks.size(), other.size()));
+        size_t n = other.size();
+        if (blocks.size() < n) {
+            blocks.resize(n, 0);
+        }
+        Limb carry = AddN(blocks.data(), blocks.data(), other.data(), n);
+        size_t i = n;
+        for (; carry && i < blocks.size(); ++i) {
+            blocks[i] += carry;
+            carry = (blocks[i] == 0);
+        }
+        if (carry) {
+            blocks.push_back(carry);
+        }
+        delete_empty_blocks();
+        return *this;
+    }
+    BigInt operator+ (BigIntView other) const& {
+        BIGINT_COUNT_OP(Add, std::max(blocks.size(), other.size()));
+        BigIntView a = view(), b = other;
+        if (a.size() < b.size()) {
+            std::swap(a, b);
+        }
+        BigInt result;
+        result.blocks.resize_uninitialized(a.size() + 1);
+        Limb* out = result.blocks.data();
+        Limb carry = AddN(out, a.data(), b.data(), b.size());
+        for (size_t i = b.size(); i < a.size(); ++i) {
+            out[i] = a[i] + carry;
+            carry = carry & (out[i] == 0);
+        }
+        out[a.size()] = carry;
+        result.delete_empty_blocks();
+        return result;
+    }
+    BigInt operator+ (BigIntView other) && {
+        *this += other;
+        return std::move(*this);
+    }
+    // subtitude
+    BigInt& operator-= (BigIntView other){
+        BIGINT_COUNT_OP(Sub, blocks.size());
+        size_t n = std::min(blocks.size(), other.size());
+        Limb borrow = SubN(blocks.data(), blocks.data(), other.data(), n);
+        size_t i = n;
+        for (; borrow && i < blocks.size(); ++i) {
+            borrow = (blocks[i] == 0);
+            blocks[i] -= 1;
+        }
+        delete_empty_blocks();
+        return *this;
+    }
+    BigInt operator- (BigIntView other) const& {
+        BIGINT_COUNT_OP(Sub, blocks.size());
+        BigInt result(*this);
+        result -= other;
+        return result;
+    }
+    BigInt operator- (BigIntView other) && {
+        *this -= other;
+        return std::move(*this);
+    }
+    //mod by a word of at most 32 bits. Wider integer types do not compile rather
+    //than being cut down to 32 bits; pass them as a BigInt instead
+    template<class T, typename std::enable_if<std::is_integral<T>::value, int>::type = 0>
+    uint32_t operator% (T mod) const{
+        static_assert(sizeof(T) <= sizeof(uint32_t), "BigInt % word: the modulus must fit in 32 bits");
+        BIGINT_COUNT_OP(ModWord, blocks.size());
+        if constexpr (std::is_signed<T>::value) {
+            if (mod < 0) {
+                throw std::domain_error("BigInt modulo by a negative number");
+            }
+        }
+        if (mod == 0) {
+            throw std::domain_error("BigInt modulo by zero");
+        }
+        LimbDivisor divisor(static_cast<uint32_t>(mod));
+        return static_cast<uint32_t>(DivRemLimbs(nullptr, blocks.data(), blocks.size(), divisor));
+    }
+    //value mod every modulus: one pass over the limbs for short values,
+    //a remainder tree over the product of the moduli for long ones
+    std::vector<uint32_t> residues(const std::vector<uint32_t>& moduli) const {
+        std::vector<uint32_t> result(moduli.size());
+        if (std::find(moduli.begin(), moduli.end(), 0u) != moduli.end()) {
+            throw std::domain_error("BigInt modulo by zero");
+        }
+        if (blocks.size() >= RESIDUE_TREE_LIMBS && moduli.size() >= RESIDUE_TREE_MODULI) {
+            ResiduesByTree(moduli, result);
+            return result;
+        }
+        std::vector<LimbDivisor> divisors;
+        divisors.reserve(moduli.size());
+        for (uint32_t m : moduli)
+            divisors.push_back(LimbDivisor(m));
+        std::vector<Limb> remainders(moduli.size(), 0);
+        for (size_t i = blocks.size(); i-- > 0;) {
+            for (size_t j = 0; j < divisors.size(); ++j)
+                remainders[j] = divisors[j].Remainder(remainders[j], blocks[i]);
+        }
+        for (size_t j = 0; j < moduli.size(); ++j)
+            result[j] = static_cast<uint32_t>(remainders[j]);
+        return result;
+    }
+    //div
+    friend std::pair<BigInt, BigInt> divmod(BigIntView a, BigIntView b);
+    friend class MontgomeryContext;
+    friend class GcdSolver;
+    friend class PrimeSolver;
+    template<size_t N> friend class BigIntExpr;
+    BigInt operator/ (BigIntView other) const {
+        return divmod(view(), other).first;
+    }
+    BigInt& operator/= (BigIntView other){
+        *this = divmod(view(), other).first;
+        return *this;
+    }
+    BigInt operator% (BigIntView other) const {
+        return divmod(view(), other).second;
+    }
+    BigInt& operator%= (BigIntView other){
+        *this = divmod(view(), other).second;
+        return *this;
+    }
+    //other operator overload
+    BigInt& operator=(const BigInt& other){
+        if (this != &other) {
+            blocks = other.blocks;
+        }
+        return *this;
+    }
+    //may copy, see LimbVector's move assignment
+    BigInt& operator=(BigInt&& other) {
+        blocks = std::move(other.blocks);
+        return *this;
+    }
+    //writes the sum into this number's limbs, keeping their capacity
+    template<size_t N>
+    BigInt& operator=(const BigIntExpr<N>& expr) {
+        expr.evalInto(*this);
+        return *this;
+    }
+    bool operator< (BigIntView other) const{
+        return Compare(view(), other) < 0;
+    }
+    bool operator> (BigIntView other) const{
+        return Compare(view(), other) > 0;
+    }
+    bool operator== (BigIntView other) const{
+        return Compare(view(), other) == 0;
+    }
+    bool operator>= (BigIntView other) const{
+        if((*this) > other || (*this) == other)
+            return true;
+        return false;
+    }
+    
+    bool operator<= (BigIntView other) const{
+        if((*this) < other || (*this) == other)
+            return true;
+        return false;
+    }
+    //mul
+    BigInt& operator*= (BigIntView other){
+        BIGINT_COUNT_OP(Mul, std::max(blocks.size(), other.size()));
+        if (blocks.empty() || other.empty()) {
+            *this = BigInt(0);
+        }
+        else if (other.size() == 1) {
+            MultiplyBySingleBlockInPlace(other[0]);
+        }
+        else {
+            *this = Multiply(view(), other);
+        }
+        return *this;
+    }
+    BigInt operator* (BigIntView other) const {
+        BIGINT_COUNT_OP(Mul, std::max(blocks.size(), other.size()));
+        return Multiply(view(), other);
+    }
+
+    //a * b with all temporaries in a caller-owned arena; products in the Toom-3 and NTT
+    //tiers still allocate their own buffers. multiplyScratch(max(a, b) limbs) is the
+    //arena size that avoids any allocation besides the result
+    static BigInt multiply(BigIntView a, BigIntView b, LimbArena& arena) {
+        BIGINT_COUNT_OP(Mul, std::max(a.size(), b.size()));
+        size_t minLen = std::min(a.size(), b.size());
+        if (minLen == 0) {
+            return BigInt(0);
+        }
+        if (minLen >= mulThresholds().toom3) {
+            return Multiply(a, b);
+        }
+        return MultiplyOnArena(a, b, arena);
+    }
+    static size_t multiplyScratch(size_t limbs) {
+        return ScratchLimbs(limbs);
+    }
+
+    //this * this with the squaring kernels, see also pow below the class
+    BigInt square() const {
+        BIGINT_COUNT_OP(Square, blocks.size());
+        if (isZero()) {
+            return BigInt(0);
+        }
+        return Square(view());
+    }
+
+    bool isZero() const {
+        return blocks.empty() || (blocks.size() == 1 && blocks[0] == 0);
+    }
+    size_t bitLength() const {
+        if (isZero())
+            return 0;
+        return blocks.size() * LIMB_BITS - __builtin_clzll(blocks.back());
+    }
+    bool testBit(size_t bit) const {
+        size_t limb = bit / LIMB_BITS;
+        return limb < blocks.size() && ((blocks[limb] >> (bit % LIMB_BITS)) & 1);
+    }
+    //uniformly distributed in [0, 2^bits); rng is any standard random bit generator
+    template<class Rng>
+    static BigInt random(size_t bits, Rng& rng) {
+        std::uniform_int_distribution<Limb> draw;
+        BigInt result;
+        result.blocks.resize((bits + LIMB_BITS - 1) / LIMB_BITS);
+        for (Limb& limb : result.blocks)
+            limb = draw(rng);
+        if (bits % LIMB_BITS != 0)
+            result.blocks.back() &= (Limb(1) << (bits % LIMB_BITS)) - 1;
+        result.delete_empty_blocks();
+        return result;
+    }
+
+    //operand sizes in limbs at which operator* switches to the next algorithm,
+    //tunable at runtime: BigInt::mulThresholds().toom3 = 200;
+    struct MulThresholds {
+        size_t karatsuba = 80;
+        size_t toom3 = 240;
+        size_t ntt = 3000;
+    };
+    static MulThresholds& mulThresholds() {
+        static MulThresholds thresholds;
+        return thresholds;
+    }
+    //divisor size in limbs from which division recurses (Burnikel-Ziegler) instead of Knuth D
+    struct DivThresholds {
+        size_t burnikelZiegler = 60;
+    };
+    static DivThresholds& divThresholds() {
+        static DivThresholds thresholds;
+        return thresholds;
+    }
+    //sizes in limbs from which gcd switches from Lehmer steps to the half-gcd, and
+    //below which the half-gcd recursion ends in Lehmer steps
+    struct GcdThresholds {
+        size_t halfGcd = 1500;
+        size_t halfGcdBase = 300;
+    };
+    static GcdThresholds& gcdThresholds() {
+        static GcdThresholds thresholds;
+        return thresholds;
+    }
+    //optional multithreaded multiplication: with threads > 1, products whose shorter
+    //operand has at least cutoff limbs fork their sub-products and split their
+    //recombination sums over a shared work-stealing pool. The result is the same
+    //as in serial mode. Each operation reads the settings once when it starts, so
+    //a change made while others run applies from the next operation on
+    struct Parallelism {
+        std::atomic<unsigned> threads{1};
+        std::atomic<size_t> cutoff{1500};
+    };
+    static Parallelism& parallelism() {
+        static Parallelism settings;
+        return settings;
+    }
+
+
+private:
+    //three-way comparison, most significant limb first; leading zero limbs are ignored
+    static int Compare(BigIntView a, BigIntView b) {
+        size_t n = a.size();
+        size_t m = b.size();
+        while (n > 0 && a[n - 1] == 0)
+            --n;
+        while (m > 0 && b[m - 1] == 0)
+            --m;
+        if (n != m)
+            return n < m ? -1 : 1;
+        for (size_t i = n; i-- > 0;) {
+            if (a[i] != b[i])
+                return a[i] < b[i] ? -1 : 1;
+        }
+        return 0;
+    }
+
+    //limbs [from, from + count) as a normalized number
+    BigInt GetBlocks(size_t from, size_t count) const {
+        return BigInt(view().slice(from, count));
+    }
+
+    static BigInt Multiply(BigIntView a, BigIntView b) {
+        size_t n = a.size();
+        size_t m = b.size();
+
+        if (n == 0 || m == 0) {
+            return BigInt(0);
+        }
+        if (IsSame(a, b)) {
+            return Square(a);
+        }
+
+        if (n == 1 || m == 1) {
+            return n == 1 ? MultiplyBySingleBlock(b, a[0]) : MultiplyBySingleBlock(a, b[0]);
+        }
+
+        const MulThresholds& tiers = mulThresholds();
+        size_t minLen = std::min(n, m);
+        if (minLen < tiers.karatsuba) {
+            return MultiplySchoolbook(a, b);
+        }
+        ParallelScope scope;
+        if (minLen >= tiers.ntt && n + m <= NTT_MAX_LIMBS) {
+            return MultiplyNTT(a, b);
+        }
+        if (std::max(n, m) >= 2 * minLen) {
+            return MultiplyUnbalanced(a, b);
+        }
+        if (minLen >= tiers.toom3) {
+            return MultiplyToom3(a, b);
+        }
+        return MultiplyKaratsuba(a, b);
+    }
+
+    //both views cover the same limbs, so their product is a square
+    static bool IsSame(BigIntView a, BigIntView b) {
+        return a.data() == b.data() && a.size() == b.size();
+    }
+    //squaring computes each cross product once: about half the work of a product
+    //in the schoolbook tier and two thirds (one sub-square fewer) above it
+    static BigInt Square(BigIntView a) {
+        size_t n = a.size();
+        const MulThresholds& tiers = mulThresholds();
+        if (n >= tiers.karatsuba) {
+            ParallelScope scope;
+            if (n >= tiers.ntt && 2 * n <= NTT_MAX_LIMBS) {
+                return MultiplyNTT(a, a);
+            }
+            if (n >= tiers.toom3) {
+                return MultiplyToom3(a, a);
+            }
+            if (ParallelPool(n) != nullptr) {
+                return MultiplyKaratsuba(a, a);
+            }
+        }
+        BigInt result;
+        result.blocks.resize_uninitialized(2 * n);
+        LimbArena& arena = ThreadArena();
+        size_t scratch = ScratchLimbs(n);
+        if (arena.reserve(scratch)) {
+            SquareLimbs(result.blocks.data(), a.data(), n, arena);
+        }
+        else {
+            LimbArena fresh(scratch);
+            SquareLimbs(result.blocks.data(), a.data(), n, fresh);
+        }
+        result.delete_empty_blocks();
+        return result;
+    }
+
+    static BigInt MultiplySchoolbook(BigIntView a, BigIntView b) {
+        BigInt result;
+        result.blocks.resize_uninitialized(a.size() + b.size());
+        SchoolbookLimbs(result.blocks.data(), a.data(), a.size(), b.data(), b.size());
+        result.delete_empty_blocks();
+        return result;
+    }
+
+    //Karatsuba with the fused recombination of BigIntExpr, defined after it below
+    static BigInt MultiplyKaratsuba(BigIntView a, BigIntView b);
+
+    //cuts the longer operand into pieces as long as the shorter one
+    static BigInt MultiplyUnbalanced(BigIntView a, BigIntView b) {
+        if (a.size() < b.size()) {
+            return MultiplyUnbalanced(b, a);
+        }
+        BIGINT_COUNT_TIER(Unbalanced);
+        size_t chunk = b.size();
+        ThreadPool* pool = ParallelPool(chunk);
+        if (pool == nullptr) {
+            BigInt result(0);
+            for (size_t from = 0; from < a.size(); from += chunk) {
+                BigInt part = Multiply(a.slice(from, chunk), b);
+                part <<= from * LIMB_BITS;
+                result += part;
+            }
+            return result;
+        }
+
+        std::vector<BigInt> parts((a.size() + chunk - 1) / chunk);
+        std::vector<std::function<void()>> tasks;
+        for (size_t i = 0; i < parts.size(); ++i) {
+            tasks.push_back([&, i] { parts[i] = Multiply(a.slice(i * chunk, chunk), b); });
+        }
+        ForkJoin(pool, std::move(tasks));
+        BigInt result(0);
+        for (size_t i = 0; i < parts.size(); ++i) {
+            AddShifted(result, parts[i], i * chunk, false, pool);
+        }
+        return result;
+    }
+
+    //limb-span multiplication for the schoolbook and Karatsuba tiers. Spans need not be
+    //normalized, out must not overlap the operands, and all temporaries come from the
+    //arena, at most multiplyScratch(max(n, m)) limbs in total
+
+    //out[0, n + m) = a * b
+    static void SchoolbookLimbs(Limb* out, const Limb* a, size_t n, const Limb* b, size_t m) {
+        BIGINT_COUNT_TIER(Schoolbook);
+        if (n == 0) {
+            std::fill(out, out + m, Limb(0));
+            return;
+        }
+        out[m] = Mul1(out, b, m, a[0]);
+        for (size_t i = 1; i < n; ++i)
+            out[i + m] = AddMul1(out + i, b, m, a[i]);
+    }
+    //x[0, n) += y[0, k) for k <= n, returns the carry out of x
+    static Limb AddTo(Limb* x, size_t n, const Limb* y, size_t k) {
+        Limb carry = AddLimbs(x, y, k);
+        for (size_t i = k; carry != 0 && i < n; ++i)
+            carry = ++x[i] == 0;
+        return carry;
+    }
+    //x[0, n) -= y[0, k) for k <= n, returns the borrow out of x
+    static Limb SubFrom(Limb* x, size_t n, const Limb* y, size_t k) {
+        Limb borrow = SubLimbs(x, y, k);
+        for (size_t i = k; borrow != 0 && i < n; ++i)
+            borrow = x[i]-- == 0;
+        return borrow;
+    }
+    //Karatsuba needs halves that shrink, whatever the tuned threshold
+    static constexpr size_t KARATSUBA_MIN_LIMBS = 8;
+
+    static void MultiplyLimbs(Limb* out, const Limb* a, size_t n, const Limb* b, size_t m, LimbArena& arena) {
+        if (n < m) {
+            std::swap(a, b);
+            std::swap(n, m);
+        }
+        if (m < std::max(mulThresholds().karatsuba, KARATSUBA_MIN_LIMBS)) {
+            SchoolbookLimbs(out, a, n, b, m);
+            return;
+        }
+        BIGINT_COUNT_TIER(Karatsuba);
+        LimbArena::Frame frame(arena);
+        size_t h = (n + 1) / 2;
+        if (n >= 2 * m || m <= h) {
+            //b has no high half: a in pieces of at most max(m, h) limbs times b
+            size_t piece = std::max(m, h);
+            Limb* part = arena.allocate(piece + m);
+            MultiplyLimbs(out, a, piece, b, m, arena);
+            std::fill(out + piece + m, out + n + m, Limb(0));
+            for (size_t from = piece; from < n; from += piece) {
+                size_t len = std::min(piece, n - from);
+                MultiplyLimbs(part, a + from, len, b, m, arena);
+                AddTo(out + from, n + m - from, part, len + m);
+            }
+            return;
+        }
+        //a = a1 * B^h + a0, b = b1 * B^h + b0 with n - h and m - h limbs on top
+        Limb* sa = arena.allocate(h + 1);
+        Limb* sb = arena.allocate(h + 1);
+        Limb* middle = arena.allocate(2 * h + 2);
+        std::memcpy(sa, a, h * sizeof(Limb));
+        std::memcpy(sb, b, h * sizeof(Limb));
+        size_t na = h + (sa[h] = AddTo(sa, h, a + h, n - h));
+        size_t nb = h + (sb[h] = AddTo(sb, h, b + h, m - h));
+
+        MultiplyLimbs(out, a, h, b, h, arena);
+        MultiplyLimbs(out + 2 * h, a + h, n - h, b + h, m - h, arena);
+        MultiplyLimbs(middle, sa, na, sb, nb, arena);
+        SubFrom(middle, na + nb, out, 2 * h);
+        SubFrom(middle, na + nb, out + 2 * h, n + m - 2 * h);
+        AddTo(out + h, n + m - h, middle, std::min(na + nb, n + m - h));
+    }
+    //out[0, 2n) = a^2: the products a[i] * a[j] for i < j once, doubled, plus the
+    //squares a[i]^2 on the diagonal
+    static void SquareSchoolbookLimbs(Limb* out, const Limb* a, size_t n) {
+        BIGINT_COUNT_TIER(Schoolbook);
+        std::fill(out, out + 2 * n, Limb(0));
+        for (size_t i = 0; i + 1 < n; ++i)
+            out[i + n] = AddMul1(out + 2 * i + 1, a + i + 1, n - i - 1, a[i]);
+        Limb shifted = 0;
+        Limb carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            DoubleLimb square = static_cast<DoubleLimb>(a[i]) * a[i];
+            Limb low = out[2 * i], high = out[2 * i + 1];
+            DoubleLimb sum = static_cast<DoubleLimb>((low << 1) | shifted) + static_cast<Limb>(square) + carry;
+            out[2 * i] = static_cast<Limb>(sum);
+            sum = static_cast<DoubleLimb>((high << 1) | (low >> (LIMB_BITS - 1))) + static_cast<Limb>(square >> LIMB_BITS) + (sum >> LIMB_BITS);
+            out[2 * i + 1] = static_cast<Limb>(sum);
+            carry = static_cast<Limb>(sum >> LIMB_BITS);
+            shifted = high >> (LIMB_BITS - 1);
+        }
+    }
+    //Karatsuba with one operand: a0^2, a1^2 and (a0 + a1)^2
+    static void SquareLimbs(Limb* out, const Limb* a, size_t n, LimbArena& arena) {
+        if (n < std::max(mulThresholds().karatsuba, KARATSUBA_MIN_LIMBS)) {
+            SquareSchoolbookLimbs(out, a, n);
+            return;
+        }
+        BIGINT_COUNT_TIER(Karatsuba);
+        LimbArena::Frame frame(arena);
+        size_t h = (n + 1) / 2;
+        Limb* sa = arena.allocate(h + 1);
+        Limb* middle = arena.allocate(2 * h + 2);
+        std::memcpy(sa, a, h * sizeof(Limb));
+        size_t na = h + (sa[h] = AddTo(sa, h, a + h, n - h));
+
+        SquareLimbs(out, a, h, arena);
+        SquareLimbs(out + 2 * h, a + h, n - h, arena);
+        SquareLimbs(middle, sa, na, arena);
+        SubFrom(middle, 2 * na, out, 2 * h);
+        SubFrom(middle, 2 * na, out + 2 * h, 2 * n - 2 * h);
+        AddTo(out + h, 2 * n - h, middle, std::min(2 * na, 2 * n - h));
+    }
+    //scratch limbs MultiplyLimbs needs for operands of at most n limbs: 2n + 6 on
+    //each level, on halves of at most n / 2 + 2 limbs
+    static size_t ScratchLimbs(size_t n) {
+        size_t total = 0;
+        while (n >= std::max(mulThresholds().karatsuba, KARATSUBA_MIN_LIMBS)) {
+            total += 2 * n + 6;
+            n = n / 2 + 2;
+        }
+        return total;
+    }
+    static LimbArena& ThreadArena() {
+        static thread_local LimbArena arena;
+        return arena;
+    }
+    static BigInt MultiplyOnArena(BigIntView a, BigIntView b, LimbArena& arena) {
+        BigInt result;
+        result.blocks.resize_uninitialized(a.size() + b.size());
+        size_t scratch = ScratchLimbs(std::max(a.size(), b.size()));
+        if (arena.reserve(scratch)) {
+            MultiplyLimbs(result.blocks.data(), a.data(), a.size(), b.data(), b.size(), arena);
+        }
+        else {
+            LimbArena fresh(scratch);
+            MultiplyLimbs(result.blocks.data(), a.data(), a.size(), b.data(), b.size(), fresh);
+        }
+        result.delete_empty_blocks();
+        return result;
+    }
+
+    //parallelism() as read by one top-level operation; every task it forks runs
+    //with the same pool and cutoff, whatever happens to parallelism() meanwhile
+    struct ParallelRun {
+        ThreadPool* pool;
+        size_t cutoff;
+    };
+    static const ParallelRun*& CurrentRun() {
+        static thread_local const ParallelRun* run = nullptr;
+        return run;
+    }
+    //makes run the thread's current one until destroyed. Without a run, reads
+    //parallelism() for a new one, unless the thread is inside an operation already
+    class ParallelScope {
+    public:
+        explicit ParallelScope(const ParallelRun* run = nullptr) : outer(CurrentRun()), own{nullptr, 0} {
+            if (run == nullptr && outer == nullptr) {
+                unsigned threads = parallelism().threads.load();
+                own.pool = threads > 1 ? &ThreadPool::shared(threads) : nullptr;
+                own.cutoff = parallelism().cutoff.load();
+                run = &own;
+            }
+            if (run != nullptr)
+                CurrentRun() = run;
+        }
+        ~ParallelScope() {
+            CurrentRun() = outer;
+        }
+        ParallelScope(const ParallelScope&) = delete;
+        ParallelScope& operator=(const ParallelScope&) = delete;
+
+        //the pool of the current run, nullptr in serial mode
+        ThreadPool* pool() const {
+            return CurrentRun()->pool;
+        }
+    private:
+        const ParallelRun* outer;
+        ParallelRun own;
+    };
+    //the pool to fork onto for a product whose shorter operand has this many limbs,
+    //nullptr in serial mode or outside a ParallelScope
+    static ThreadPool* ParallelPool(size_t limbs) {
+        const ParallelRun* run = CurrentRun();
+        if (run == nullptr || run->pool == nullptr || limbs < run->cutoff)
+            return nullptr;
+        return run->pool;
+    }
+    //runs the last task on the calling thread and the others on the pool, all of
+    //them within the caller's ParallelScope
+    static void ForkJoin(ThreadPool* pool, std::vector<std::function<void()>> tasks) {
+        if (pool == nullptr) {
+            for (std::function<void()>& task : tasks)
+                task();
+            return;
+        }
+        ThreadPool::TaskGroup group;
+        const ParallelRun* run = CurrentRun();
+        for (size_t i = 0; i + 1 < tasks.size(); ++i) {
+            pool->run(group, [run, task = std::move(tasks[i])] {
+                ParallelScope scope(run);
+                task();
+            });
+        }
+        std::exception_ptr error;
+        try {
+            tasks.back()();
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        pool->wait(group);
+        if (error)
+            std::rethrow_exception(error);
+    }
+
+    //carry-chain kernels on limb spans, the base of all the arithmetic above one limb
+    //(GMP's mpn_add_n, mpn_sub_n, mpn_mul_1, mpn_addmul_1 and mpn_submul_1).
+    //out may equal a or b, but must not overlap them otherwise. On x86-64 CPUs with
+    //ADX and BMI2 they run as assembly loops over 4 limbs: mulx leaves the flags alone,
+    //so addmul/submul keep two carry chains in flight, one through adcx (CF) and one
+    //through adox (OF). Everywhere else the portable __int128 loops are used
+    struct LimbKernels {
+        Limb (*addN)(Limb* out, const Limb* a, const Limb* b, size_t n);
+        Limb (*subN)(Limb* out, const Limb* a, const Limb* b, size_t n);
+        Limb (*mul1)(Limb* out, const Limb* a, size_t n, Limb v);
+        Limb (*addMul1)(Limb* out, const Limb* a, size_t n, Limb v);
+        Limb (*subMul1)(Limb* out, const Limb* a, size_t n, Limb v);
+    };
+    //out = a + b, returns the carry out
+    static Limb AddN(Limb* out, const Limb* a, const Limb* b, size_t n) {
+        return Kernels().addN(out, a, b, n);
+    }
+    //out = a - b, returns the borrow out
+    static Limb SubN(Limb* out, const Limb* a, const Limb* b, size_t n) {
+        return Kernels().subN(out, a, b, n);
+    }
+    //out = a * v, returns the high limb
+    static Limb Mul1(Limb* out, const Limb* a, size_t n, Limb v) {
+        return Kernels().mul1(out, a, n, v);
+    }
+    //out += a * v, returns the carry limb
+    static Limb AddMul1(Limb* out, const Limb* a, size_t n, Limb v) {
+        return Kernels().addMul1(out, a, n, v);
+    }
+    //out -= a * v, returns the borrow limb
+    static Limb SubMul1(Limb* out, const Limb* a, size_t n, Limb v) {
+        return Kernels().subMul1(out, a, n, v);
+    }
+    static const LimbKernels& Kernels() {
+        static const LimbKernels kernels = SelectLimbKernels();
+        return kernels;
+    }
+    static LimbKernels SelectLimbKernels() {
+#ifdef BIGINT_X86_DISPATCH
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("adx") && __builtin_cpu_supports("bmi2"))
+            return {AddNAdx, SubNAdx, Mul1Adx, AddMul1Adx, SubMul1Adx};
+#endif
+        return {AddNPortable, SubNPortable, Mul1Portable, AddMul1Portable, SubMul1Portable};
+    }
+
+    static Limb AddNPortable(Limb* out, const Limb* a, const Limb* b, size_t n) {
+        return AddNLoop(out, a, b, n, 0);
+    }
+    static Limb SubNPortable(Limb* out, const Limb* a, const Limb* b, size_t n) {
+        return SubNLoop(out, a, b, n, 0);
+    }
+    static Limb Mul1Portable(Limb* out, const Limb* a, size_t n, Limb v) {
+        return Mul1Loop(out, a, n, v, 0);
+    }
+    static Limb AddMul1Portable(Limb* out, const Limb* a, size_t n, Limb v) {
+        return AddMul1Loop(out, a, n, v, 0);
+    }
+    static Limb SubMul1Portable(Limb* out, const Limb* a, size_t n, Limb v) {
+        return SubMul1Loop(out, a, n, v, 0);
+    }
+    //the loops take a carry in, so the assembly kernels can leave them the tail
+    static Limb AddNLoop(Limb* out, const Limb* a, const Limb* b, size_t n, Limb carry) {
+        for (size_t i = 0; i < n; ++i) {
+            DoubleLimb sum = static_cast<DoubleLimb>(a[i]) + b[i] + carry;
+            out[i] = static_cast<Limb>(sum);
+            carry = static_cast<Limb>(sum >> LIMB_BITS);
+        }
+        return carry;
+    }
+    static Limb SubNLoop(Limb* out, const Limb* a, const Limb* b, size_t n, Limb borrow) {
+        for (size_t i = 0; i < n; ++i) {
+            DoubleLimb diff = static_cast<DoubleLimb>(a[i]) - b[i] - borrow;
+            out[i] = static_cast<Limb>(diff);
+            borrow = static_cast<Limb>(diff >> LIMB_BITS) & 1;
+        }
+        return borrow;
+    }
+    static Limb Mul1Loop(Limb* out, const Limb* a, size_t n, Limb v, Limb carry) {
+        for (size_t i = 0; i < n; ++i) {
+            DoubleLimb product = static_cast<DoubleLimb>(a[i]) * v + carry;
+            out[i] = static_cast<Limb>(product);
+            carry = static_cast<Limb>(product >> LIMB_BITS);
+        }
+        return carry;
+    }
+    static Limb AddMul1Loop(Limb* out, const Limb* a, size_t n, Limb v, Limb carry) {
+        for (size_t i = 0; i < n; ++i) {
+            DoubleLimb product = static_cast<DoubleLimb>(a[i]) * v + out[i] + carry;
+            out[i] = static_cast<Limb>(product);
+            carry = static_cast<Limb>(product >> LIMB_BITS);
+        }
+        return carry;
+    }
+    static Limb SubMul1Loop(Limb* out, const Limb* a, size_t n, Limb v, Limb borrow) {
+        for (size_t i = 0; i < n; ++i) {
+            DoubleLimb product = static_cast<DoubleLimb>(a[i]) * v + borrow;
+            Limb low = static_cast<Limb>(product);
+            borrow = static_cast<Limb>(product >> LIMB_BITS) + (out[i] < low);
+            out[i] -= low;
+        }
+        return borrow;
+    }
+#ifdef BIGINT_X86_DISPATCH
+    //each kernel runs whole groups of 4 limbs in assembly and the rest portably.
+    //Loop counters are stepped with lea and tested with jrcxz where a flag must
+    //survive the iteration
+    static Limb AddNAdx(Limb* out, const Limb* a, const Limb* b, size_t n) {
+        size_t groups = n / 4;
+        Limb carry = 0;
+        if (groups != 0) {
+            __asm__ volatile(
+                "xor %k[carry], %k[carry]\n\t"
+                "1:\n\t"
+                "mov (%[a]), %%r8\n\t"
+                "mov 8(%[a]), %%r9\n\t"
+                "mov 16(%[a]), %%r10\n\t"
+                "mov 24(%[a]), %%r11\n\t"
+                "adc (%[b]), %%r8\n\t"
+                "adc 8(%[b]), %%r9\n\t"
+                "adc 16(%[b]), %%r10\n\t"
+                "adc 24(%[b]), %%r11\n\t"
+                "mov %%r8, (%[out])\n\t"
+                "mov %%r9, 8(%[out])\n\t"
+                "mov %%r10, 16(%[out])\n\t"
+                "mov %%r11, 24(%[out])\n\t"
+                "lea 32(%[a]), %[a]\n\t"
+                "lea 32(%[b]), %[b]\n\t"
+                "lea 32(%[out]), %[out]\n\t"
+                "dec %[groups]\n\t"
+                "jnz 1b\n\t"
+                "setc %b[carry]\n\t"
+                : [out] "+r"(out), [a] "+r"(a), [b] "+r"(b), [groups] "+r"(groups), [carry] "=&r"(carry)
+                :
+                : "r8", "r9", "r10", "r11", "cc", "memory");
+        }
+        return AddNLoop(out, a, b, n % 4, carry);
+    }
+    static Limb SubNAdx(Limb* out, const Limb* a, const Limb* b, size_t n) {
+        size_t groups = n / 4;
+        Limb borrow = 0;
+        if (groups != 0) {
+            __asm__ volatile(
+                "xor %k[borrow], %k[borrow]\n\t"
+                "1:\n\t"
+                "mov (%[a]), %%r8\n\t"
+                "mov 8(%[a]), %%r9\n\t"
+                "mov 16(%[a]), %%r10\n\t"
+                "mov 24(%[a]), %%r11\n\t"
+                "sbb (%[b]), %%r8\n\t"
+                "sbb 8(%[b]), %%r9\n\t"
+                "sbb 16(%[b]), %%r10\n\t"
+                "sbb 24(%[b]), %%r11\n\t"
+                "mov %%r8, (%[out])\n\t"
+                "mov %%r9, 8(%[out])\n\t"
+                "mov %%r10, 16(%[out])\n\t"
+                "mov %%r11, 24(%[out])\n\t"
+                "lea 32(%[a]), %[a]\n\t"
+                "lea 32(%[b]), %[b]\n\t"
+                "lea 32(%[out]), %[out]\n\t"
+                "dec %[groups]\n\t"
+                "jnz 1b\n\t"
+                "setc %b[borrow]\n\t"
+                : [out] "+r"(out), [a] "+r"(a), [b] "+r"(b), [groups] "+r"(groups), [borrow] "=&r"(borrow)
+                :
+                : "r8", "r9", "r10", "r11", "cc", "memory");
+        }
+        return SubNLoop(out, a, b, n % 4, borrow);
+    }
+    //one carry chain; it ends in every group since the top limb of a product
+    //has room for the carry
+    static Limb Mul1Adx(Limb* out, const Limb* a, size_t n, Limb v) {
+        size_t groups = n / 4;
+        Limb carry = 0;
+        if (groups != 0) {
+            __asm__ volatile(
+                "1:\n\t"
+                "mulx (%[a]), %%r8, %%r9\n\t"
+                "mulx 8(%[a]), %%r10, %%r11\n\t"
+                "mulx 16(%[a]), %%r12, %%r13\n\t"
+                "mulx 24(%[a]), %%r14, %%r15\n\t"
+                "add %[carry], %%r8\n\t"
+                "adc %%r9, %%r10\n\t"
+                "adc %%r11, %%r12\n\t"
+                "adc %%r13, %%r14\n\t"
+                "adc $0, %%r15\n\t"
+                "mov %%r8, (%[out])\n\t"
+                "mov %%r10, 8(%[out])\n\t"
+                "mov %%r12, 16(%[out])\n\t"
+                "mov %%r14, 24(%[out])\n\t"
+                "mov %%r15, %[carry]\n\t"
+                "lea 32(%[a]), %[a]\n\t"
+                "lea 32(%[out]), %[out]\n\t"
+                "dec %[groups]\n\t"
+                "jnz 1b\n\t"
+                : [out] "+r"(out), [a] "+r"(a), [groups] "+r"(groups), [carry] "+r"(carry)
+                : "d"(v)
+                : "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory");
+        }
+        return Mul1Loop(out, a, n % 4, v, carry);
+    }
+    //low halves plus the previous high half on the CF chain, plus out on the OF chain
+    static Limb AddMul1Adx(Limb* out, const Limb* a, size_t n, Limb v) {
+        size_t groups = n / 4;
+        Limb carry = 0;
+        if (groups != 0) {
+            __asm__ volatile(
+                "xor %%r8d, %%r8d\n\t"
+                "1:\n\t"
+                "mulx (%[a]), %%r8, %%r9\n\t"
+                "mulx 8(%[a]), %%r10, %%r11\n\t"
+                "adcx %[carry], %%r8\n\t"
+                "adox (%[out]), %%r8\n\t"
+                "mov %%r8, (%[out])\n\t"
+                "mulx 16(%[a]), %%r12, %%r13\n\t"
+                "adcx %%r9, %%r10\n\t"
+                "adox 8(%[out]), %%r10\n\t"
+                "mov %%r10, 8(%[out])\n\t"
+                "mulx 24(%[a]), %%r14, %[carry]\n\t"
+                "adcx %%r11, %%r12\n\t"
+                "adox 16(%[out]), %%r12\n\t"
+                "mov %%r12, 16(%[out])\n\t"
+                "adcx %%r13, %%r14\n\t"
+                "adox 24(%[out]), %%r14\n\t"
+                "mov %%r14, 24(%[out])\n\t"
+                "lea 32(%[a]), %[a]\n\t"
+                "lea 32(%[out]), %[out]\n\t"
+                "lea -1(%[groups]), %[groups]\n\t"
+                "jrcxz 2f\n\t"
+                "jmp 1b\n\t"
+                "2:\n\t"
+                "mov $0, %%r8d\n\t"
+                "adcx %%r8, %[carry]\n\t"
+                "adox %%r8, %[carry]\n\t"
+                : [out] "+r"(out), [a] "+r"(a), [groups] "+c"(groups), [carry] "+r"(carry)
+                : "d"(v)
+                : "r8", "r9", "r10", "r11", "r12", "r13", "r14", "cc", "memory");
+        }
+        return AddMul1Loop(out, a, n % 4, v, carry);
+    }
+    //low halves plus the previous high half on the OF chain. sbb would clobber OF, so
+    //out - t - borrow is taken as ~(~out + t + carry) on the CF chain of adcx
+    static Limb SubMul1Adx(Limb* out, const Limb* a, size_t n, Limb v) {
+        size_t groups = n / 4;
+        Limb borrow = 0;
+        if (groups != 0) {
+            __asm__ volatile(
+                "xor %%r8d, %%r8d\n\t"
+                "1:\n\t"
+                "mulx (%[a]), %%r8, %%r9\n\t"
+                "mulx 8(%[a]), %%r10, %%r11\n\t"
+                "adox %[borrow], %%r8\n\t"
+                "mov (%[out]), %%r15\n\t"
+                "not %%r15\n\t"
+                "adcx %%r8, %%r15\n\t"
+                "not %%r15\n\t"
+                "mov %%r15, (%[out])\n\t"
+                "mulx 16(%[a]), %%r12, %%r13\n\t"
+                "adox %%r9, %%r10\n\t"
+                "mov 8(%[out]), %%r15\n\t"
+                "not %%r15\n\t"
+                "adcx %%r10, %%r15\n\t"
+                "not %%r15\n\t"
+                "mov %%r15, 8(%[out])\n\t"
+                "mulx 24(%[a]), %%r14, %[borrow]\n\t"
+                "adox %%r11, %%r12\n\t"
+                "mov 16(%[out]), %%r15\n\t"
+                "not %%r15\n\t"
+                "adcx %%r12, %%r15\n\t"
+                "not %%r15\n\t"
+                "mov %%r15, 16(%[out])\n\t"
+                "adox %%r13, %%r14\n\t"
+                "mov 24(%[out]), %%r15\n\t"
+                "not %%r15\n\t"
+                "adcx %%r14, %%r15\n\t"
+                "not %%r15\n\t"
+                "mov %%r15, 24(%[out])\n\t"
+                "lea 32(%[a]), %[a]\n\t"
+                "lea 32(%[out]), %[out]\n\t"
+                "lea -1(%[groups]), %[groups]\n\t"
+                "jrcxz 2f\n\t"
+                "jmp 1b\n\t"
+                "2:\n\t"
+                "mov $0, %%r8d\n\t"
+                "adox %%r8, %[borrow]\n\t"
+                "adcx %%r8, %[borrow]\n\t"
+                : [out] "+r"(out), [a] "+r"(a), [groups] "+c"(groups), [borrow] "+r"(borrow)
+                : "d"(v)
+                : "r8", "r9", "r10", "r11", "r12", "r13", "r14", "r15", "cc", "memory");
+        }
+        return SubMul1Loop(out, a, n % 4, v, borrow);
+    }
+#endif
+    //x[0, n) += y[0, n), returns the carry out
+    static Limb AddLimbs(Limb* x, const Limb* y, size_t n) {
+        return AddN(x, x, y, n);
+    }
+    //x[0, n) -= y[0, n), returns the borrow out
+    static Limb SubLimbs(Limb* x, const Limb* y, size_t n) {
+        return SubN(x, x, y, n);
+    }
+    //x += y * B^offset, or x -= y * B^offset when subtract (x must not become negative).
+    //The limbs of y are split into one chunk per pool thread; each chunk is added by its
+    //own task and the carries out of the chunks are rippled in order afterwards
+    static void AddShifted(BigInt& x, BigIntView y, size_t offset, bool subtract, ThreadPool* pool) {
+        size_t n = y.size();
+        if (x.blocks.size() < offset + n) {
+            x.blocks.resize(offset + n, 0);
+        }
+        size_t chunks = pool == nullptr ? 1 : std::min<size_t>(pool->size(), n / PARALLEL_ADD_LIMBS + 1);
+        size_t chunk = (n + chunks - 1) / chunks;
+        std::vector<Limb> carries(chunks, 0);
+        std::vector<std::function<void()>> tasks;
+        for (size_t c = 0; c < chunks; ++c) {
+            tasks.push_back([&, c] {
+                size_t from = std::min(n, c * chunk);
+                size_t count = std::min(n, from + chunk) - from;
+                Limb* target = x.blocks.data() + offset + from;
+                carries[c] = subtract ? SubLimbs(target, y.data() + from, count)
+                                      : AddLimbs(target, y.data() + from, count);
+            });
+        }
+        ForkJoin(chunks > 1 ? pool : nullptr, std::move(tasks));
+
+        for (size_t c = 0; c < chunks; ++c) {
+            if (carries[c] == 0)
+                continue;
+            size_t i = offset + std::min(n, (c + 1) * chunk);
+            if (subtract) {
+                while (x.blocks[i] == 0)
+                    x.blocks[i++] = ~Limb(0);
+                --x.blocks[i];
+            }
+            else {
+                while (i < x.blocks.size() && x.blocks[i] == ~Limb(0))
+                    x.blocks[i++] = 0;
+                if (i == x.blocks.size())
+                    x.blocks.push_back(1);
+                else
+                    ++x.blocks[i];
+            }
+        }
+        x.delete_empty_blocks();
+    }
+    //below this many limbs per thread a sum is not worth splitting
+    static constexpr size_t PARALLEL_ADD_LIMBS = 4096;
+
+    //Toom-Cook 3-way split, defined after SignedBigInt below
+    static BigInt MultiplyToom3(BigIntView a, BigIntView b);
+
+    //three-prime number-theoretic transform over 32-bit coefficients, joined by CRT
+    static constexpr uint32_t NTT_PRIME_1 = 2013265921u; // 15 * 2^27 + 1
+    static constexpr uint32_t NTT_PRIME_2 = 1811939329u; // 27 * 2^26 + 1
+    static constexpr uint32_t NTT_PRIME_3 = 469762049u;  //  7 * 2^26 + 1
+    static constexpr size_t NTT_MAX_COEFFS = size_t(1) << 26;
+    //each limb is two coefficients and the product needs n + m limbs
+    static constexpr size_t NTT_MAX_LIMBS = NTT_MAX_COEFFS / 2;
+
+    static uint32_t PowMod32(uint64_t base, uint64_t exp, uint32_t mod) {
+        uint64_t result = 1;
+        base %= mod;
+        while (exp) {
+            if (exp & 1)
+                result = result * base % mod;
+            base = base * base % mod;
+            exp >>= 1;
+        }
+        return static_cast<uint32_t>(result);
+    }
+
+    template <uint32_t MOD, uint32_t ROOT>
+    static void NttTransform(std::vector<uint32_t>& a, bool invert) {
+        size_t n = a.size();
+        for (size_t i = 1, j = 0; i < n; ++i) {
+            size_t bit = n >> 1;
+            for (; j & bit; bit >>= 1)
+                j ^= bit;
+            j ^= bit;
+            if (i < j)
+                std::swap(a[i], a[j]);
+        }
+        std::vector<uint32_t> roots(n / 2);
+        for (size_t len = 2; len <= n; len <<= 1) {
+            uint32_t step = PowMod32(ROOT, (MOD - 1) / len, MOD);
+            if (invert)
+                step = PowMod32(step, MOD - 2, MOD);
+            size_t half = len / 2;
+            roots[0] = 1;
+            for (size_t i = 1; i < half; ++i)
+                roots[i] = static_cast<uint32_t>(static_cast<uint64_t>(roots[i - 1]) * step % MOD);
+            for (size_t i = 0; i < n; i += len) {
+                for (size_t j = 0; j < half; ++j) {
+                    uint32_t u = a[i + j];
+                    uint32_t v = static_cast<uint32_t>(static_cast<uint64_t>(a[i + j + half]) * roots[j] % MOD);
+                    a[i + j] = u + v >= MOD ? u + v - MOD : u + v;
+                    a[i + j + half] = u >= v ? u - v : u + MOD - v;
+                }
+            }
+        }
+        if (invert) {
+            uint64_t nInv = PowMod32(n, MOD - 2, MOD);
+            for (size_t i = 0; i < n; ++i)
+                a[i] = static_cast<uint32_t>(a[i] * nInv % MOD);
+        }
+    }
+
+    template <uint32_t MOD, uint32_t ROOT>
+    static std::vector<uint32_t> NttConvolve(const std::vector<uint32_t>& x, const std::vector<uint32_t>& y, size_t size) {
+        bool square = &x == &y;
+        std::vector<uint32_t> fx(x), fy;
+        fx.resize(size, 0);
+        for (size_t i = 0; i < size; ++i)
+            fx[i] %= MOD;
+        NttTransform<MOD, ROOT>(fx, false);
+        if (!square) {
+            fy = y;
+            fy.resize(size, 0);
+            for (size_t i = 0; i < size; ++i)
+                fy[i] %= MOD;
+            NttTransform<MOD, ROOT>(fy, false);
+        }
+        const std::vector<uint32_t>& gy = square ? fx : fy;
+        for (size_t i = 0; i < size; ++i)
+            fx[i] = static_cast<uint32_t>(static_cast<uint64_t>(fx[i]) * gy[i] % MOD);
+        NttTransform<MOD, ROOT>(fx, true);
+        return fx;
+    }
+
+    static std::vector<uint32_t> ToHalfBlocks(BigIntView x) {
+        std::vector<uint32_t> halves(x.size() * 2);
+        for (size_t i = 0; i < x.size(); ++i) {
+            halves[2 * i] = static_cast<uint32_t>(x[i]);
+            halves[2 * i + 1] = static_cast<uint32_t>(x[i] >> 32);
+        }
+        return halves;
+    }
+
+    static BigInt MultiplyNTT(BigIntView a, BigIntView b) {
+        BIGINT_COUNT_TIER(Ntt);
+        //a square transforms its operand once
+        std::vector<uint32_t> x = ToHalfBlocks(a);
+        std::vector<uint32_t> other;
+        if (!IsSame(a, b))
+            other = ToHalfBlocks(b);
+        const std::vector<uint32_t>& y = IsSame(a, b) ? x : other;
+        size_t coeffs = x.size() + y.size() - 1;
+        size_t size = 1;
+        while (size < coeffs)
+            size <<= 1;
+
+        //the three convolutions are independent and run side by side in parallel mode
+        std::vector<uint32_t> c1, c2, c3;
+        ForkJoin(ParallelPool(std::min(a.size(), b.size())), {
+            [&] { c1 = NttConvolve<NTT_PRIME_1, 31>(x, y, size); },
+            [&] { c2 = NttConvolve<NTT_PRIME_2, 13>(x, y, size); },
+            [&] { c3 = NttConvolve<NTT_PRIME_3, 3>(x, y, size); }
+        });
+
+        //Garner's algorithm: value = r1 + p1 * t1 + p1 * p2 * t2
+        const uint64_t p1 = NTT_PRIME_1, p2 = NTT_PRIME_2, p3 = NTT_PRIME_3;
+        const uint64_t p1InvP2 = PowMod32(p1, p2 - 2, p2);
+        const uint64_t p12InvP3 = PowMod32(p1 * p2 % p3, p3 - 2, p3);
+
+        BigInt result;
+        result.blocks.resize(a.size() + b.size(), 0);
+        DoubleLimb carry = 0;
+        for (size_t i = 0; i < 2 * result.blocks.size(); ++i) {
+            if (i < coeffs) {
+                uint64_t r1 = c1[i], r2 = c2[i], r3 = c3[i];
+                uint64_t t1 = (r2 + p2 - r1 % p2) % p2 * p1InvP2 % p2;
+                uint64_t partial = (r1 + p1 % p3 * t1) % p3;
+                uint64_t t2 = (r3 + p3 - partial) % p3 * p12InvP3 % p3;
+                carry += static_cast<DoubleLimb>(r1) + static_cast<DoubleLimb>(p1) * t1
+                       + static_cast<DoubleLimb>(p1 * p2) * t2;
+            }
+            uint32_t coeff = static_cast<uint32_t>(carry);
+            carry >>= 32;
+            if (i % 2 == 0)
+                result.blocks[i / 2] = coeff;
+            else
+                result.blocks[i / 2] |= static_cast<Limb>(coeff) << 32;
+        }
+        result.delete_empty_blocks();
+        return result;
+    }
+
+    //Knuth, TAOCP vol. 2, 4.3.1, Algorithm D
+    static void DivideKnuth(BigIntView a, BigIntView b, BigInt& quotient, BigInt& remainder) {
+        BIGINT_COUNT_TIER(KnuthD);
+        if (Compare(a, b) < 0) {
+            quotient = BigInt(0);
+            remainder = BigInt(a);
+            return;
+        }
+        if (b.size() == 1) {
+            quotient = BigInt(a);
+            remainder = BigInt(quotient.DivideBySingleBlockInPlace(b[0]));
+            return;
+        }
+        size_t shift = __builtin_clzll(b.back());
+        BigInt v = BigInt(b) << shift;
+        BigInt u = BigInt(a) << shift;
+        size_t n = v.blocks.size();
+        u.blocks.resize(a.size() + 1, 0);
+        size_t m = u.blocks.size() - n - 1;
+        Limb* un = u.blocks.data();
+        const Limb* vn = v.blocks.data();
+
+        quotient.blocks.clear();
+        quotient.blocks.resize(m + 1, 0);
+        for (size_t j = m + 1; j-- > 0;) {
+            DoubleLimb numerator = (static_cast<DoubleLimb>(un[j + n]) << LIMB_BITS) | un[j + n - 1];
+            DoubleLimb qhat = numerator / vn[n - 1];
+            DoubleLimb rhat = numerator % vn[n - 1];
+            while ((qhat >> LIMB_BITS) != 0 ||
+                   qhat * vn[n - 2] > ((rhat << LIMB_BITS) | un[j + n - 2])) {
+                --qhat;
+                rhat += vn[n - 1];
+                if ((rhat >> LIMB_BITS) != 0)
+                    break;
+            }
+
+            Limb borrow = SubMul1(un + j, vn, n, static_cast<Limb>(qhat));
+            bool negative = un[j + n] < borrow;
+            un[j + n] -= borrow;
+
+            if (negative) {
+                --qhat;
+                un[j + n] += AddN(un + j, un + j, vn, n);
+            }
+            quotient.blocks[j] = static_cast<Limb>(qhat);
+        }
+        quotient.delete_empty_blocks();
+        u.blocks.resize(n);
+        u.delete_empty_blocks();
+        remainder = std::move(u) >> shift;
+    }
+
+    //Burnikel-Ziegler, "Fast Recursive Division" (1998).
+    //a < b * B^n, b has n limbs and its top bit set
+    static void Divide2n1n(const BigInt& a, const BigInt& b, size_t n, BigInt& quotient, BigInt& remainder) {
+        if (n % 2 != 0 || n < divThresholds().burnikelZiegler) {
+            DivideKnuth(a, b, quotient, remainder);
+            return;
+        }
+        size_t half = n / 2;
+        BigInt q1, q2, r1;
+        Divide3n2n(a.GetBlocks(half, 3 * half), b, half, q1, r1);
+        r1 <<= half * LIMB_BITS;
+        r1 += a.GetBlocks(0, half);
+        Divide3n2n(r1, b, half, q2, remainder);
+        quotient = std::move(q1) << (half * LIMB_BITS);
+        quotient += q2;
+    }
+
+    //a = [a1 a2 a3] and b = [b1 b2] in half-limb parts, a < b * B^half
+    static void Divide3n2n(const BigInt& a, const BigInt& b, size_t half, BigInt& quotient, BigInt& remainder) {
+        BigInt a12 = a.GetBlocks(half, 2 * half);
+        BigInt b1 = b.GetBlocks(half, half);
+        BigInt c;
+        if (a.GetBlocks(2 * half, half) < b1) {
+            Divide2n1n(a12, b1, half, quotient, c);
+        }
+        else {
+            //q = B^half - 1, c = [a1 a2] - q * b1
+            quotient.blocks.clear();
+            quotient.blocks.resize(half, ~Limb(0));
+            c = std::move(a12) + b1;
+            c -= b1 << (half * LIMB_BITS);
+        }
+        BigInt d = quotient * b.GetBlocks(0, half);
+        c <<= half * LIMB_BITS;
+        c += a.GetBlocks(0, half);
+        while (c < d) {
+            quotient -= BigInt(1);
+            c += b;
+        }
+        remainder = std::move(c) - d;
+    }
+
+    static void DivideBurnikelZiegler(BigIntView a, BigIntView b, BigInt& quotient, BigInt& remainder) {
+        BIGINT_COUNT_TIER(BurnikelZiegler);
+        size_t s = b.size();
+        size_t m = 1;
+        while (m * divThresholds().burnikelZiegler <= s)
+            m <<= 1;
+        size_t n = (s + m - 1) / m * m;
+        size_t shift = (n - s) * LIMB_BITS + __builtin_clzll(b.back());
+        BigInt bs = BigInt(b) << shift;
+        BigInt as = BigInt(a) << shift;
+
+        size_t t = (as.blocks.size() + n - 1) / n;
+        if (!(as.GetBlocks((t - 1) * n, n) < bs))
+            ++t;
+        t = std::max<size_t>(t, 2);
+
+        quotient.blocks.clear();
+        quotient.blocks.resize((t - 1) * n, 0);
+        BigInt z = as.GetBlocks((t - 2) * n, 2 * n);
+        BigInt qi, ri;
+        for (size_t i = t - 1; i-- > 0;) {
+            Divide2n1n(z, bs, n, qi, ri);
+            std::copy(qi.blocks.begin(), qi.blocks.end(), quotient.blocks.begin() + i * n);
+            if (i > 0) {
+                z = std::move(ri) << (n * LIMB_BITS);
+                z += as.GetBlocks((i - 1) * n, n);
+            }
+        }
+        quotient.delete_empty_blocks();
+        remainder = std::move(ri) >> shift;
+    }
+
+    //a divisor with its precomputed reciprocal, so dividing by it needs no hardware
+    //divide (Moller, Granlund, "Improved division by invariant integers", 2011)
+    struct LimbDivisor {
+        Limb d;      //divisor shifted so its top bit is set
+        Limb v;      //floor((B^2 - 1) / d) - B
+        int shift;
+
+        explicit LimbDivisor(Limb divisor) : shift(__builtin_clzll(divisor)) {
+            d = divisor << shift;
+            v = static_cast<Limb>(((static_cast<DoubleLimb>(~d) << LIMB_BITS) | ~Limb(0)) / d);
+        }
+        //(u1:u0) / d for u1 < d
+        Limb DivRem(Limb u1, Limb u0, Limb& remainder) const {
+            DoubleLimb q = static_cast<DoubleLimb>(v) * u1 + ((static_cast<DoubleLimb>(u1) << LIMB_BITS) | u0);
+            Limb q1 = static_cast<Limb>(q >> LIMB_BITS) + 1;
+            Limb q0 = static_cast<Limb>(q);
+            Limb r = u0 - q1 * d;
+            if (r > q0) {
+                --q1;
+                r += d;
+            }
+            if (r >= d) {
+                ++q1;
+                r -= d;
+            }
+            remainder = r;
+            return q1;
+        }
+        //(r * B + u) mod divisor for r < divisor
+        Limb Remainder(Limb r, Limb u) const {
+            Limb scaled;
+            if (shift == 0) {
+                DivRem(r, u, scaled);
+                return scaled;
+            }
+            DivRem((r << shift) | (u >> (LIMB_BITS - shift)), u << shift, scaled);
+            return scaled >> shift;
+        }
+    };
+
+    //u / divisor into q (q may be u or null), returns the remainder
+    static Limb DivRemLimbs(Limb* q, const Limb* u, size_t n, const LimbDivisor& divisor) {
+        Limb r = 0;
+        int s = divisor.shift;
+        for (size_t i = n; i-- > 0;) {
+            Limb scaled;
+            Limb digit;
+            if (s == 0) {
+                digit = divisor.DivRem(r, u[i], scaled);
+                r = scaled;
+            }
+            else {
+                digit = divisor.DivRem((r << s) | (u[i] >> (LIMB_BITS - s)), u[i] << s, scaled);
+                r = scaled >> s;
+            }
+            if (q)
+                q[i] = digit;
+        }
+        return r;
+    }
+
+    //divides in place by a single limb, returns the remainder
+    Limb DivideBySingleBlockInPlace(Limb divisor) {
+        Limb remainder = DivRemLimbs(blocks.data(), blocks.data(), blocks.size(), LimbDivisor(divisor));
+        delete_empty_blocks();
+        return remainder;
+    }
+
+    //value of a hex digit, or -1
+    static int HexDigitValue(char c) {
+        if (c >= '0' && c <= '9')
+            return c - '0';
+        c |= 0x20;
+        if (c >= 'a' && c <= 'f')
+            return c - 'a' + 10;
+        return -1;
+    }
+
+    //up to 16 hex digits, most significant first
+    static Limb ParseHexLimb(const char* digits, size_t len) {
+#ifdef __SSE2__
+        if (len == 16) {
+            __m128i c = _mm_loadu_si128(reinterpret_cast<const __m128i*>(digits));
+            __m128i lower = _mm_or_si128(c, _mm_set1_epi8(0x20));
+            __m128i isDigit = _mm_and_si128(_mm_cmpgt_epi8(c, _mm_set1_epi8('0' - 1)),
+                                            _mm_cmplt_epi8(c, _mm_set1_epi8('9' + 1)));
+            __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(lower, _mm_set1_epi8('a' - 1)),
+                                             _mm_cmplt_epi8(lower, _mm_set1_epi8('f' + 1)));
+            if (_mm_movemask_epi8(_mm_or_si128(isDigit, isLetter)) != 0xFFFF) {
+                throw std::invalid_argument("BigInt::setHex: not a hex digit");
+            }
+            __m128i nibbles = _mm_or_si128(
+                _mm_and_si128(isDigit, _mm_sub_epi8(c, _mm_set1_epi8('0'))),
+                _mm_andnot_si128(isDigit, _mm_sub_epi8(lower, _mm_set1_epi8('a' - 10))));
+            //each 16-bit lane holds (first digit, second digit); join them into one byte
+            __m128i bytes = _mm_or_si128(_mm_slli_epi16(_mm_and_si128(nibbles, _mm_set1_epi16(0x00FF)), 4),
+                                         _mm_srli_epi16(nibbles, 8));
+            Limb packed = static_cast<Limb>(_mm_cvtsi128_si64(_mm_packus_epi16(bytes, bytes)));
+            return __builtin_bswap64(packed);
+        }
+#endif
+        Limb value = 0;
+        for (size_t i = 0; i < len; ++i) {
+            int digit = HexDigitValue(digits[i]);
+            if (digit < 0) {
+                throw std::invalid_argument("BigInt::setHex: not a hex digit");
+            }
+            value = (value << 4) | static_cast<Limb>(digit);
+        }
+        return value;
+    }
+
+    //16 uppercase hex digits, most significant first
+    static void FormatHexLimb(Limb value, char* out) {
+#ifdef __SSE2__
+        __m128i x = _mm_cvtsi64_si128(static_cast<long long>(__builtin_bswap64(value)));
+        __m128i high = _mm_and_si128(_mm_srli_epi16(x, 4), _mm_set1_epi8(0x0F));
+        __m128i low = _mm_and_si128(x, _mm_set1_epi8(0x0F));
+        __m128i nibbles = _mm_unpacklo_epi8(high, low);
+        __m128i letters = _mm_and_si128(_mm_cmpgt_epi8(nibbles, _mm_set1_epi8(9)), _mm_set1_epi8('A' - '0' - 10));
+        __m128i chars = _mm_add_epi8(_mm_add_epi8(nibbles, _mm_set1_epi8('0')), letters);
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), chars);
+#else
+        static const char digits[] = "0123456789ABCDEF";
+        for (int i = 15; i >= 0; --i) {
+            out[i] = digits[value & 0xF];
+            value >>= 4;
+        }
+#endif
+    }
+
+    //up to 64 binary digits, most significant first; 8 digits are folded
+    //into a byte with one multiplication
+    static Limb ParseBinLimb(const char* digits, size_t len) {
+        Limb value = 0;
+        size_t i = 0;
+        for (; i + 8 <= len; i += 8) {
+            uint64_t chunk;
+            std::memcpy(&chunk, digits + i, 8);
+            chunk -= 0x3030303030303030ull;
+            if ((chunk & ~0x0101010101010101ull) != 0) {
+                throw std::invalid_argument("BigInt::setBin: not a binary digit");
+            }
+            value = (value << 8) | ((chunk * 0x8040201008040201ull) >> 56);
+        }
+        for (; i < len; ++i) {
+            if (digits[i] != '0' && digits[i] != '1') {
+                throw std::invalid_argument("BigInt::setBin: not a binary digit");
+            }
+            value = (value << 1) | static_cast<Limb>(digits[i] - '0');
+        }
+        return value;
+    }
+
+    //8 binary digits of one byte: the byte is copied to every byte of a word,
+    //byte k keeps bit 7 - k and is turned into '0' or '1'
+    static void FormatBinByte(uint8_t byte, char* out) {
+        uint64_t bits = (byte * 0x0101010101010101ull) & 0x0102040810204080ull;
+        bits = ((bits + 0x7F7F7F7F7F7F7F7Full) & 0x8080808080808080ull) >> 7;
+        bits |= 0x3030303030303030ull;
+        std::memcpy(out, &bits, 8);
+    }
+
+    static constexpr Limb DEC_CHUNK = 10000000000000000000ull; // 10^19, the largest power of 10 in a limb
+    static constexpr size_t DEC_CHUNK_DIGITS = 19;
+    //below this many limbs conversion works chunk by chunk with single-limb multiply/divide
+    static constexpr size_t DEC_SPLIT_LIMBS = 40;
+
+    //10^(19 * 2^k), squared on demand and kept per thread
+    static const BigInt& DecimalPower(size_t k) {
+        static thread_local std::vector<BigInt> powers;
+        if (powers.empty())
+            powers.push_back(BigInt(DEC_CHUNK));
+        while (powers.size() <= k)
+            powers.push_back(powers.back() * powers.back());
+        return powers[k];
+    }
+
+    static BigInt ParseDec(const char* digits, size_t len) {
+        if (len <= DEC_SPLIT_LIMBS * DEC_CHUNK_DIGITS) {
+            BigInt result(0);
+            size_t first = len % DEC_CHUNK_DIGITS;
+            if (first == 0)
+                first = DEC_CHUNK_DIGITS;
+            for (size_t pos = 0; pos < len;) {
+                size_t take = pos == 0 ? first : DEC_CHUNK_DIGITS;
+                Limb chunk = 0;
+                Limb scale = 1;
+                for (size_t i = 0; i < take; ++i) {
+                    chunk = chunk * 10 + (digits[pos + i] - '0');
+                    scale *= 10;
+                }
+                result.MultiplyBySingleBlockInPlace(scale);
+                result += BigInt(chunk);
+                pos += take;
+            }
+            return result;
+        }
+        size_t k = 0;
+        while ((DEC_CHUNK_DIGITS << (k + 1)) < len)
+            ++k;
+        size_t lowLen = DEC_CHUNK_DIGITS << k;
+        BigInt result = ParseDec(digits, len - lowLen) * DecimalPower(k);
+        result += ParseDec(digits + len - lowLen, lowLen);
+        return result;
+    }
+
+    //writes exactly width digits of x (zero padded) to out
+    static void FormatDec(const BigInt& x, char* out, size_t width) {
+        if (x.blocks.size() <= DEC_SPLIT_LIMBS) {
+            BigInt rest(x);
+            LimbDivisor divisor(DEC_CHUNK);
+            size_t pos = width;
+            while (!rest.isZero() && pos > 0) {
+                Limb chunk = DivRemLimbs(rest.blocks.data(), rest.blocks.data(), rest.blocks.size(), divisor);
+                rest.delete_empty_blocks();
+                for (size_t i = 0; i < DEC_CHUNK_DIGITS && pos > 0; ++i) {
+                    out[--pos] = static_cast<char>('0' + chunk % 10);
+                    chunk /= 10;
+                }
+            }
+            std::fill(out, out + pos, '0');
+            return;
+        }
+        size_t k = 0;
+        while (2 * DecimalPower(k + 1).blocks.size() <= x.blocks.size() + 1)
+            ++k;
+        size_t lowWidth = DEC_CHUNK_DIGITS << k;
+        std::pair<BigInt, BigInt> qr = divmod(x, DecimalPower(k));
+        FormatDec(qr.first, out, width - lowWidth);
+        FormatDec(qr.second, out + width - lowWidth, lowWidth);
+    }
+
+    static constexpr size_t RESIDUE_TREE_LIMBS = 96;
+    static constexpr size_t RESIDUE_TREE_MODULI = 16;
+
+    //product tree of the moduli (two per leaf limb), then remainders pushed from the root down
+    void ResiduesByTree(const std::vector<uint32_t>& moduli, std::vector<uint32_t>& result) const {
+        std::vector<std::vector<BigInt>> tree(1);
+        for (size_t i = 0; i < moduli.size(); i += 2) {
+            Limb leaf = moduli[i];
+            if (i + 1 < moduli.size())
+                leaf *= moduli[i + 1];
+            tree[0].push_back(BigInt(leaf));
+        }
+        while (tree.back().size() > 1) {
+            const std::vector<BigInt>& below = tree.back();
+            std::vector<BigInt> level;
+            for (size_t i = 0; i < below.size(); i += 2)
+                level.push_back(i + 1 < below.size() ? below[i] * below[i + 1] : below[i]);
+            tree.push_back(std::move(level));
+        }
+
+        std::vector<BigInt> remainders(1, *this % tree.back()[0]);
+        for (size_t level = tree.size() - 1; level-- > 0;) {
+            std::vector<BigInt> next;
+            next.reserve(tree[level].size());
+            for (size_t i = 0; i < tree[level].size(); ++i)
+                next.push_back(remainders[i / 2] % tree[level][i]);
+            remainders = std::move(next);
+        }
+        for (size_t i = 0; i < moduli.size(); ++i)
+            result[i] = static_cast<uint32_t>(remainders[i / 2].blocks[0] % moduli[i]);
+    }
+
+    static BigInt MultiplyBySingleBlock(BigIntView a, Limb multiplier) {
+        BIGINT_COUNT_TIER(SingleLimb);
+        BigInt result;
+        result.blocks.resize_uninitialized(a.size() + 1);
+        result.blocks[a.size()] = Mul1(result.blocks.data(), a.data(), a.size(), multiplier);
+        result.delete_empty_blocks();
+        return result;
+    }
+    void MultiplyBySingleBlockInPlace(Limb multiplier) {
+        BIGINT_COUNT_TIER(SingleLimb);
+        Limb carry = Mul1(blocks.data(), blocks.data(), blocks.size(), multiplier);
+        if (carry != 0) {
+            blocks.push_back(carry);
+        }
+        delete_empty_blocks();
+    }
+    //shift engine: whole-limb move and in-limb funnel shift in one pass into an
+    //output of exactly the final size. out may be in; a left shift walks down and a
+    //right shift walks up, so no limb is overwritten before it is read
+    static size_t ShiftedLeftSize(BigIntView x, size_t n) {
+        size_t bits = n % LIMB_BITS;
+        size_t size = x.size() + n / LIMB_BITS;
+        if (bits != 0 && (x.back() >> (LIMB_BITS - bits)) != 0)
+            ++size;
+        return size;
+    }
+    static size_t ShiftedRightSize(BigIntView x, size_t n) {
+        size_t words = n / LIMB_BITS;
+        if (words >= x.size())
+            return 1;
+        size_t size = x.size() - words;
+        if (size > 1 && (x.back() >> (n % LIMB_BITS)) == 0)
+            --size;
+        return size;
+    }
+    static void ShiftLeftLimbs(Limb* out, size_t outLength, const Limb* in, size_t length, size_t n) {
+        size_t words = n / LIMB_BITS;
+        int bits = n % LIMB_BITS;
+        if (bits == 0) {
+            std::memmove(out + words, in, length * sizeof(Limb));
+        }
+        else {
+            if (outLength > length + words)
+                out[length + words] = in[length - 1] >> (LIMB_BITS - bits);
+            for (size_t i = length - 1; i > 0; --i)
+                out[i + words] = (in[i] << bits) | (in[i - 1] >> (LIMB_BITS - bits));
+            out[words] = in[0] << bits;
+        }
+        std::fill(out, out + words, Limb(0));
+    }
+    static void ShiftRightLimbs(Limb* out, size_t outLength, const Limb* in, size_t length, size_t n) {
+        size_t words = n / LIMB_BITS;
+        int bits = n % LIMB_BITS;
+        if (words >= length) {
+            out[0] = 0;
+            return;
+        }
+        if (bits == 0) {
+            std::memmove(out, in + words, outLength * sizeof(Limb));
+            return;
+        }
+        size_t top = length - words - 1;
+        for (size_t i = 0; i < top; ++i)
+            out[i] = (in[i + words] >> bits) | (in[i + words + 1] << (LIMB_BITS - bits));
+        if (outLength > top)
+            out[top] = in[length - 1] >> bits;
+    }
+    //bitwise kernels over limb spans, out may alias a or b. The widest vector unit of
+    //the running CPU is picked once; b is ignored for Not
+    enum class BitOp { And, Or, Xor, Not };
+    typedef void (*BitwiseKernel)(BitOp op, Limb* out, const Limb* a, const Limb* b, size_t n);
+
+    static void BitwiseScalar(BitOp op, Limb* out, const Limb* a, const Limb* b, size_t n) {
+        switch (op) {
+        case BitOp::And:
+            for (size_t i = 0; i < n; ++i)
+                out[i] = a[i] & b[i];
+            break;
+        case BitOp::Or:
+            for (size_t i = 0; i < n; ++i)
+                out[i] = a[i] | b[i];
+            break;
+        case BitOp::Xor:
+            for (size_t i = 0; i < n; ++i)
+                out[i] = a[i] ^ b[i];
+            break;
+        case BitOp::Not:
+            for (size_t i = 0; i < n; ++i)
+                out[i] = ~a[i];
+            break;
+        }
+    }
+#ifdef __SSE2__
+    static void BitwiseSSE2(BitOp op, Limb* out, const Limb* a, const Limb* b, size_t n) {
+        const __m128i ones = _mm_set1_epi32(-1);
+        size_t i = 0;
+        for (; i + 2 <= n; i += 2) {
+            __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(a + i));
+            __m128i y = op == BitOp::Not ? ones : _mm_loadu_si128(reinterpret_cast<const __m128i*>(b + i));
+            __m128i r = op == BitOp::And ? _mm_and_si128(x, y) :
+                        op == BitOp::Or ? _mm_or_si128(x, y) : _mm_xor_si128(x, y);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), r);
+        }
+        BitwiseScalar(op, out + i, a + i, b ? b + i : nullptr, n - i);
+    }
+#endif
+#ifdef BIGINT_X86_DISPATCH
+    __attribute__((target("avx2")))
+    static void BitwiseAVX2(BitOp op, Limb* out, const Limb* a, const Limb* b, size_t n) {
+        const __m256i ones = _mm256_set1_epi32(-1);
+        size_t i = 0;
+        for (; i + 4 <= n; i += 4) {
+            __m256i x = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(a + i));
+            __m256i y = op == BitOp::Not ? ones : _mm256_loadu_si256(reinterpret_cast<const __m256i*>(b + i));
+            __m256i r = op == BitOp::And ? _mm256_and_si256(x, y) :
+                        op == BitOp::Or ? _mm256_or_si256(x, y) : _mm256_xor_si256(x, y);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), r);
+        }
+        BitwiseScalar(op, out + i, a + i, b ? b + i : nullptr, n - i);
+    }
+    __attribute__((target("avx512f")))
+    static void BitwiseAVX512(BitOp op, Limb* out, const Limb* a, const Limb* b, size_t n) {
+        const __m512i ones = _mm512_set1_epi32(-1);
+        size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m512i x = _mm512_loadu_si512(a + i);
+            __m512i y = op == BitOp::Not ? ones : _mm512_loadu_si512(b + i);
+            __m512i r = op == BitOp::And ? _mm512_and_si512(x, y) :
+                        op == BitOp::Or ? _mm512_or_si512(x, y) : _mm512_xor_si512(x, y);
+            _mm512_storeu_si512(out + i, r);
+        }
+        BitwiseScalar(op, out + i, a + i, b ? b + i : nullptr, n - i);
+    }
+#endif
+    static BitwiseKernel SelectBitwiseKernel() {
+#ifdef BIGINT_X86_DISPATCH
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx512f"))
+            return BitwiseAVX512;
+        if (__builtin_cpu_supports("avx2"))
+            return BitwiseAVX2;
+#endif
+#ifdef __SSE2__
+        return BitwiseSSE2;
+#else
+        return BitwiseScalar;
+#endif
+    }
+    static void BitwiseLimbs(BitOp op, Limb* out, const Limb* a, const Limb* b, size_t n) {
+        static const BitwiseKernel kernel = SelectBitwiseKernel();
+        if (n < 8) {
+            BitwiseScalar(op, out, a, b, n);
+        }
+        else {
+            kernel(op, out, a, b, n);
+        }
+    }
+    //a op b into a fresh number; the longer operand's extra limbs are copied
+    //for Or/Xor and dropped for And
+    static BigInt Bitwise(BitOp op, BigIntView a, BigIntView b) {
+        if (a.size() < b.size()) {
+            std::swap(a, b);
+        }
+        size_t common = b.size();
+        size_t length = op == BitOp::And ? common : a.size();
+        BigInt result;
+        result.blocks.resize_uninitialized(length);
+        BitwiseLimbs(op, result.blocks.data(), a.data(), b.data(), common);
+        std::memcpy(result.blocks.data() + common, a.data() + common, (length - common) * sizeof(Limb));
+        result.delete_empty_blocks();
+        return result;
+    }
+    BigInt& BitwiseInPlace(BitOp op, BigIntView other) {
+        size_t n = blocks.size();
+        size_t m = other.size();
+        if (op == BitOp::And) {
+            blocks.resize(std::min(n, m));
+        }
+        else if (n < m) {
+            blocks.resize_uninitialized(m);
+            std::memcpy(blocks.data() + n, other.data() + n, (m - n) * sizeof(Limb));
+        }
+        BitwiseLimbs(op, blocks.data(), blocks.data(), other.data(), std::min(n, m));
+        delete_empty_blocks();
+        return *this;
+    }
+    void _INV_for_last_block(){
+        Limb lastBlock = blocks.back();
+        int leadingZeros = __builtin_clzll(lastBlock);
+        if (leadingZeros < LIMB_BITS) {
+            lastBlock ^= (~Limb(0) >> leadingZeros);
+        }
+        blocks.back() = lastBlock;
+    }
+    void delete_empty_blocks(){
+        while (!blocks.empty() && blocks.back() == 0 && blocks.size() != 1) {
+            blocks.pop_back();
+        }
+    }
+    LimbVector blocks;
+};
+
+
+inline BigIntView::BigIntView(const BigInt& number) : BigIntView(number.view()) {
+}
+
+//quotient and remainder of a / b
+inline std::pair<BigInt, BigInt> divmod(BigIntView a, BigIntView b) {
+    BIGINT_COUNT_OP(DivMod, a.size());
+    if (b.isZero()) {
+        throw std::domain_error("BigInt division by zero");
+    }
+    BigInt quotient, remainder;
+    size_t threshold = BigInt::divThresholds().burnikelZiegler;
+    if (b.size() < threshold || a.size() < b.size() + threshold) {
+        BigInt::DivideKnuth(a, b, quotient, remainder);
+    }
+    else {
+        BigInt::DivideBurnikelZiegler(a, b, quotient, remainder);
+    }
+    return std::make_pair(std::move(quotient), std::move(remainder));
+}
+
+//base^exponent, left to right over a sliding window of exponent bits: each bit costs a
+//square, each window one multiplication by a precomputed odd power of base
+inline BigInt pow(const BigInt& base, uint64_t exponent) {
+    if (exponent == 0) {
+        return BigInt(1);
+    }
+    if (base.bitLength() <= 1) {
+        return base.isZero() ? BigInt(0) : BigInt(1);
+    }
+    //a power of two only needs a shift
+    BigIntView limbs(base);
+    size_t top = base.bitLength() - 1;
+    if (limbs.back() == (Limb(1) << (top % BigInt::LIMB_BITS)) &&
+        std::all_of(limbs.begin(), limbs.end() - 1, [](Limb limb) { return limb == 0; })) {
+        if (exponent > SIZE_MAX / BigInt::LIMB_BITS / top) {
+            throw std::length_error("pow: result too large");
+        }
+        return BigInt(1) << top * exponent;
+    }
+
+    int bits = 64 - __builtin_clzll(exponent);
+    int window = bits <= 8 ? 1 : bits <= 24 ? 3 : 4;
+    //table[k] = base^(2k + 1)
+    std::vector<BigInt> table(size_t(1) << (window - 1));
+    table[0] = base;
+    if (table.size() > 1) {
+        BigInt square = base.square();
+        for (size_t k = 1; k < table.size(); ++k)
+            table[k] = table[k - 1] * square;
+    }
+
+    BigInt result(1);
+    int i = bits;
+    while (i > 0) {
+        if (((exponent >> (i - 1)) & 1) == 0) {
+            result = result.square();
+            --i;
+            continue;
+        }
+        int low = std::max(i - window, 0);
+        while (((exponent >> low) & 1) == 0)
+            ++low;
+        for (int b = i; b > low; --b)
+            result = result.square();
+        result *= table[((exponent >> low) & ((uint64_t(1) << (i - low)) - 1)) >> 1];
+        i = low;
+    }
+    return result;
+}
+
+//one term of a BigIntExpr: value << shift bits, subtracted when negative
+struct BigIntTerm {
+    BigIntView value;
+    size_t shift = 0;
+    bool negative = false;
+};
+
+//a sum of shifted terms +-(x << bits), built by lazy(x), +, - and <<. Nothing is
+//computed until the expression is assigned to a BigInt or eval() is called; then all
+//terms are added in one carry pass straight into the result, a block of limbs at a
+//time, so every operand limb is read once and every result limb written once.
+//The terms are views: an expression must not outlive its operands, so evaluate it in
+//the statement that builds it. A negative total throws std::domain_error
+template<size_t N>
+class BigIntExpr {
+public:
+    std::array<BigIntTerm, N> terms;
+
+    BigInt eval() const {
+        BigInt result;
+        evalInto(result);
+        return result;
+    }
+    void evalInto(BigInt& out) const {
+        size_t limbs = 1;
+        for (const BigIntTerm& term : terms) {
+            if (!term.value.isZero())
+                limbs = std::max(limbs, term.value.size() + (term.shift + BigInt::LIMB_BITS - 1) / BigInt::LIMB_BITS);
+        }
+        //room for the carries of up to N terms
+        limbs += 1;
+        BIGINT_COUNT_OP(Add, limbs);
+        //terms reading out's own limbs would see them overwritten
+        for (const BigIntTerm& term : terms) {
+            const Limb* data = term.value.data();
+            if (!out.blocks.empty() && data >= out.blocks.data() && data < out.blocks.data() + out.blocks.size()) {
+                out = eval();
+                return;
+            }
+        }
+        out.blocks.resize_uninitialized(limbs);
+        Limb* result = out.blocks.data();
+
+        BigInt::ParallelScope scope;
+        ThreadPool* pool = BigInt::ParallelPool(limbs);
+        size_t chunks = pool == nullptr ? 1 : std::min<size_t>(pool->size(), limbs / BigInt::PARALLEL_ADD_LIMBS + 1);
+        size_t chunk = (limbs + chunks - 1) / chunks;
+        std::vector<int64_t> carries(chunks, 0);
+        std::vector<std::function<void()>> tasks;
+        for (size_t c = 0; c < chunks; ++c) {
+            tasks.push_back([&, c] {
+                size_t from = std::min(limbs, c * chunk);
+                carries[c] = EvalRange(result, from, std::min(limbs, from + chunk));
+            });
+        }
+        BigInt::ForkJoin(chunks > 1 ? pool : nullptr, std::move(tasks));
+
+        //the carry out of each chunk goes into the ones above it, in order
+        int64_t top = 0;
+        for (size_t c = 0; c < chunks; ++c) {
+            size_t end = std::min(limbs, (c + 1) * chunk);
+            top += ApplyCarry(result + end, limbs - end, carries[c]);
+        }
+        if (top != 0) {
+            throw std::domain_error("BigIntExpr: negative result");
+        }
+        out.delete_empty_blocks();
+    }
+
+private:
+    //limbs per block; terms that don't cover a whole block, or are shifted by bits,
+    //are first staged into a block-sized buffer
+    static constexpr size_t BLOCK_LIMBS = 256;
+
+    //out[from, to) = the low limbs of the sum of the terms on that range; returns
+    //the signed carry out of the range
+    int64_t EvalRange(Limb* out, size_t from, size_t to) const {
+        static const Limb zeros[BLOCK_LIMBS] = {};
+        Limb staged[N][BLOCK_LIMBS];
+        const Limb* sources[N];
+        //-x = ~x + 1 - B: subtracted limbs are complemented, and the 1 - B of each
+        //goes into the sum once per limb
+        Limb masks[N];
+        unsigned __int128 bias = 0;
+        for (size_t t = 0; t < N; ++t) {
+            masks[t] = terms[t].negative ? ~Limb(0) : 0;
+            if (terms[t].negative)
+                bias += 1 - (static_cast<unsigned __int128>(1) << BigInt::LIMB_BITS);
+        }
+        int64_t carry = 0;
+        for (size_t block = from; block < to; block += BLOCK_LIMBS) {
+            size_t len = std::min(BLOCK_LIMBS, to - block);
+            for (size_t t = 0; t < N; ++t) {
+                sources[t] = Stage(terms[t], block, len, staged[t]);
+                if (sources[t] == nullptr)
+                    sources[t] = zeros;
+            }
+            //one pass: each result limb is the sum of the term limbs plus the carry,
+            //which stays within a few units either way
+            for (size_t k = 0; k < len; ++k) {
+                unsigned __int128 sum = static_cast<unsigned __int128>(static_cast<__int128>(carry)) + bias;
+                for (size_t t = 0; t < N; ++t)
+                    sum += sources[t][k] ^ masks[t];
+                out[block + k] = static_cast<Limb>(sum);
+                carry = static_cast<int64_t>(static_cast<__int128>(sum) >> BigInt::LIMB_BITS);
+            }
+        }
+        return carry;
+    }
+    //limbs [block, block + len) of the shifted term: a pointer into the operand when
+    //it covers them all at a whole-limb shift, otherwise staged into buffer; nullptr
+    //when they are all zero
+    static const Limb* Stage(const BigIntTerm& term, size_t block, size_t len, Limb* buffer) {
+        size_t limbShift = term.shift / BigInt::LIMB_BITS;
+        int bitShift = static_cast<int>(term.shift % BigInt::LIMB_BITS);
+        size_t size = term.value.isZero() ? 0 : term.value.size();
+        //the term covers result limbs [limbShift, limbShift + size (+ 1))
+        size_t lo = std::max(block, limbShift);
+        size_t hi = std::min(block + len, limbShift + size + (bitShift != 0 && size != 0));
+        if (lo >= hi)
+            return nullptr;
+        const Limb* x = term.value.data();
+        if (bitShift == 0 && lo == block && hi == block + len)
+            return x + (block - limbShift);
+        std::fill(buffer, buffer + (lo - block), Limb(0));
+        for (size_t j = lo; j < hi; ++j) {
+            size_t i = j - limbShift;
+            if (bitShift == 0) {
+                buffer[j - block] = x[i];
+                continue;
+            }
+            Limb high = i < size ? x[i] << bitShift : 0;
+            Limb low = i > 0 ? x[i - 1] >> (BigInt::LIMB_BITS - bitShift) : 0;
+            buffer[j - block] = high | low;
+        }
+        std::fill(buffer + (hi - block), buffer + len, Limb(0));
+        return buffer;
+    }
+    //x[0, n) += carry, returns the carry out of x
+    static int64_t ApplyCarry(Limb* x, size_t n, int64_t carry) {
+        if (carry == 0 || n == 0)
+            return carry;
+        Limb magnitude = carry > 0 ? Limb(carry) : Limb(0) - Limb(carry);
+        if (carry > 0)
+            return BigInt::AddTo(x, n, &magnitude, 1);
+        return -static_cast<int64_t>(BigInt::SubFrom(x, n, &magnitude, 1));
+    }
+};
+
+//starts a BigIntExpr with the term x. Evaluating an expression whose total is
+//negative throws std::domain_error, while operator- with a larger subtrahend does
+//not check and silently returns a wrapped, meaningless value
+inline BigIntExpr<1> lazy(BigIntView x) {
+    BigIntExpr<1> e;
+    e.terms[0].value = x;
+    return e;
+}
+template<size_t N, size_t M>
+BigIntExpr<N + M> Join(const BigIntExpr<N>& a, const BigIntExpr<M>& b, bool negate) {
+    BigIntExpr<N + M> e;
+    for (size_t i = 0; i < N; ++i)
+        e.terms[i] = a.terms[i];
+    for (size_t i = 0; i < M; ++i) {
+        e.terms[N + i] = b.terms[i];
+        e.terms[N + i].negative ^= negate;
+    }
+    return e;
+}
+template<size_t N, size_t M>
+BigIntExpr<N + M> operator+ (const BigIntExpr<N>& a, const BigIntExpr<M>& b) {
+    return Join(a, b, false);
+}
+template<size_t N, size_t M>
+BigIntExpr<N + M> operator- (const BigIntExpr<N>& a, const BigIntExpr<M>& b) {
+    return Join(a, b, true);
+}
+template<size_t N>
+BigIntExpr<N + 1> operator+ (const BigIntExpr<N>& a, BigIntView b) {
+    return Join(a, lazy(b), false);
+}
+template<size_t N>
+BigIntExpr<N + 1> operator- (const BigIntExpr<N>& a, BigIntView b) {
+    return Join(a, lazy(b), true);
+}
+template<size_t N>
+BigIntExpr<N + 1> operator+ (BigIntView a, const BigIntExpr<N>& b) {
+    return Join(lazy(a), b, false);
+}
+template<size_t N>
+BigIntExpr<N + 1> operator- (BigIntView a, const BigIntExpr<N>& b) {
+    return Join(lazy(a), b, true);
+}
+template<size_t N>
+BigIntExpr<N> operator<< (BigIntExpr<N> e, size_t bits) {
+    for (auto& term : e.terms)
+        term.shift += bits;
+    return e;
+}
+
+//the halves are views into the operands. Serially the whole recursion runs on
+//limb spans in the thread's scratch arena; in parallel mode on BigInt values
+inline BigInt BigInt::MultiplyKaratsuba(BigIntView a, BigIntView b) {
+    ThreadPool* pool = ParallelPool(std::min(a.size(), b.size()));
+    if (pool == nullptr) {
+        return MultiplyOnArena(a, b, ThreadArena());
+    }
+    BIGINT_COUNT_TIER(Karatsuba);
+
+    size_t maxLen = std::max(a.size(), b.size());
+    size_t halfLen = maxLen / 2;
+
+    BigIntView a0 = a.slice(0, halfLen), a1 = a.slice(halfLen, maxLen);
+    BigIntView b0 = b.slice(0, halfLen), b1 = b.slice(halfLen, maxLen);
+
+    BigInt p1, p2, p3;
+    ForkJoin(pool, {
+        [&] { p1 = Multiply(a1, b1); },
+        [&] { p2 = Multiply(a0, b0); },
+        [&] {
+            BigInt sa = lazy(a0) + a1;
+            p3 = IsSame(a, b) ? Multiply(sa, sa) : Multiply(sa, BigInt(lazy(b0) + b1));
+        }
+    });
+    //p2 + p3 * B^halfLen + p1 * B^(2 * halfLen) with p3 = (a0 + a1)(b0 + b1) - p1 - p2
+    size_t shift = halfLen * LIMB_BITS;
+    return lazy(p2) + ((lazy(p3) - p1 - p2) << shift) + (lazy(p1) << 2 * shift);
+}
+
+//magnitude with a sign, for the negative evaluation points of Toom-3
+struct SignedBigInt {
+    BigInt value;
+    bool negative = false;
+
+    static SignedBigInt Add(const SignedBigInt& a, const SignedBigInt& b) {
+        SignedBigInt result;
+        if (a.negative == b.negative) {
+            result.value = a.value + b.value;
+            result.negative = a.negative;
+        }
+        else if (a.value >= b.value) {
+            result.value = a.value - b.value;
+            result.negative = a.negative;
+        }
+        else {
+            result.value = b.value - a.value;
+            result.negative = b.negative;
+        }
+        if (result.value.isZero()) {
+            result.negative = false;
+        }
+        return result;
+    }
+    static SignedBigInt Sub(const SignedBigInt& a, SignedBigInt b) {
+        b.negative = !b.negative && !b.value.isZero();
+        return Add(a, b);
+    }
+    static SignedBigInt Mul(const SignedBigInt& a, const SignedBigInt& b) {
+        SignedBigInt result;
+        result.value = a.value * b.value;
+        result.negative = (a.negative != b.negative) && !result.value.isZero();
+        return result;
+    }
+    //x = x2 * B^2k + x1 * B^k + x0 at 0, 1, -1, -2 and infinity
+    static std::array<SignedBigInt, 5> EvaluateToom3(BigIntView x, size_t k) {
+        SignedBigInt x0{BigInt(x.slice(0, k))}, x1{BigInt(x.slice(k, k))}, x2{BigInt(x.slice(2 * k, k))};
+        SignedBigInt t = Add(x0, x2);
+        SignedBigInt at1 = Add(t, x1);
+        SignedBigInt atm1 = Sub(t, x1);
+        SignedBigInt atm2 = Add(atm1, x2);
+        atm2.value <<= 1;
+        atm2 = Sub(atm2, x0);
+        return {std::move(x0), std::move(at1), std::move(atm1), std::move(atm2), std::move(x2)};
+    }
+};
+
+//Toom-Cook 3-way split, evaluation points 0, 1, -1, -2, inf (Bodrato's sequence)
+inline BigInt BigInt::MultiplyToom3(BigIntView a, BigIntView b) {
+    BIGINT_COUNT_TIER(Toom3);
+    size_t k = (std::max(a.size(), b.size()) + 2) / 3;
+
+    //values at 0, 1, -1, -2 and infinity; a square evaluates its operand once and
+    //multiplies every value by itself, which Multiply turns into squares
+    std::array<SignedBigInt, 5> va = SignedBigInt::EvaluateToom3(a, k);
+    std::array<SignedBigInt, 5> vb;
+    if (!IsSame(a, b))
+        vb = SignedBigInt::EvaluateToom3(b, k);
+    const std::array<SignedBigInt, 5>& wb = IsSame(a, b) ? va : vb;
+
+    SignedBigInt r0, r1, rm1, rm2, rinf;
+    ForkJoin(ParallelPool(std::min(a.size(), b.size())), {
+        [&] { r0 = SignedBigInt::Mul(va[0], wb[0]); },
+        [&] { r1 = SignedBigInt::Mul(va[1], wb[1]); },
+        [&] { rm1 = SignedBigInt::Mul(va[2], wb[2]); },
+        [&] { rm2 = SignedBigInt::Mul(va[3], wb[3]); },
+        [&] { rinf = SignedBigInt::Mul(va[4], wb[4]); }
+    });
+
+    SignedBigInt r3 = SignedBigInt::Sub(rm2, r1);
+    r3.value.DivideBySingleBlockInPlace(3);
+    r1 = SignedBigInt::Sub(r1, rm1);
+    r1.value >>= 1;
+    SignedBigInt r2 = SignedBigInt::Sub(rm1, r0);
+    r3 = SignedBigInt::Sub(r2, r3);
+    r3.value >>= 1;
+    SignedBigInt twiceInf = rinf;
+    twiceInf.value <<= 1;
+    r3 = SignedBigInt::Add(r3, twiceInf);
+    r2 = SignedBigInt::Sub(SignedBigInt::Add(r2, r1), rinf);
+    r1 = SignedBigInt::Sub(r1, r3);
+
+    BigInt result = std::move(rinf.value);
+    result <<= k * LIMB_BITS;
+    result += r3.value;
+    result <<= k * LIMB_BITS;
+    result += r2.value;
+    result <<= k * LIMB_BITS;
+    result += r1.value;
+    result <<= k * LIMB_BITS;
+    result += r0.value;
+    return result;
+}
+
+
+//a * x + b * y = gcd, see extended_gcd
+struct ExtendedGcd {
+    BigInt gcd;
+    SignedBigInt x;
+    SignedBigInt y;
+};
+
+//Euclid's algorithm in three tiers: binary gcd once both numbers fit in two limbs,
+//Lehmer steps driven by the top 126 bits for medium sizes, and a recursive half-gcd
+//from BigInt::gcdThresholds().halfGcd limbs. Each step is a 2x2 integer matrix of
+//determinant +-1, so the gcd is kept even by steps that are not exact Euclid steps
+class GcdSolver {
+public:
+    static BigInt Gcd(BigIntView a, BigIntView b) {
+        return Run(BigInt(a), BigInt(b), nullptr);
+    }
+    //x in [0, b / gcd) (x = 1 for b = 0), y = (gcd - a * x) / b
+    static ExtendedGcd Extended(BigIntView a, BigIntView b) {
+        ExtendedGcd result;
+        if (b.isZero()) {
+            result.gcd = BigInt(a);
+            result.x.value = BigInt(a.isZero() ? 0 : 1);
+            result.y.value = BigInt(0);
+            return result;
+        }
+        //only the coefficients of a are tracked
+        Matrix u = Matrix::Identity(1);
+        result.gcd = Run(BigInt(a), BigInt(b), &u);
+        BigInt period = BigInt(b) / result.gcd;
+        BigInt x = u.m[0][0].value % period;
+        if (u.m[0][0].negative && !x.isZero())
+            x = period - x;
+        //a * x - gcd is a multiple of b
+        SignedBigInt ax{BigInt(a) * x};
+        SignedBigInt rest = SignedBigInt::Sub(ax, SignedBigInt{result.gcd});
+        result.y.value = rest.value / b;
+        result.y.negative = !rest.negative && !result.y.value.isZero();
+        result.x.value = std::move(x);
+        return result;
+    }
+
+private:
+    //(a', b') = M (a, b) for the input (a, b) and the current pair (a', b'). With one
+    //column only the coefficients of the first input are kept
+    struct Matrix {
+        SignedBigInt m[2][2];
+        int columns = 2;
+
+        static Matrix Identity(int columns) {
+            Matrix u;
+            u.columns = columns;
+            for (int i = 0; i < 2; ++i)
+                for (int j = 0; j < columns; ++j)
+                    u.m[i][j].value = BigInt(i == j ? 1 : 0);
+            return u;
+        }
+        void NegateRow(int i) {
+            for (int j = 0; j < columns; ++j)
+                m[i][j].negative = !m[i][j].negative && !m[i][j].value.isZero();
+        }
+        void SwapRows() {
+            for (int j = 0; j < columns; ++j)
+                std::swap(m[0][j], m[1][j]);
+        }
+    };
+
+    static SignedBigInt Dot(const SignedBigInt& p, const SignedBigInt& x, const SignedBigInt& q, const SignedBigInt& y) {
+        return SignedBigInt::Add(SignedBigInt::Mul(p, x), SignedBigInt::Mul(q, y));
+    }
+    //s * r, the transform r followed by s
+    static Matrix Product(const Matrix& s, const Matrix& r) {
+        Matrix result;
+        result.columns = r.columns;
+        for (int i = 0; i < 2; ++i)
+            for (int j = 0; j < r.columns; ++j)
+                result.m[i][j] = Dot(s.m[i][0], r.m[0][j], s.m[i][1], r.m[1][j]);
+        return result;
+    }
+
+    //reduces (a, b) to (gcd, 0)
+    static BigInt Run(BigInt a, BigInt b, Matrix* u) {
+        a.delete_empty_blocks();
+        b.delete_empty_blocks();
+        if (a < b) {
+            std::swap(a, b);
+            if (u)
+                u->SwapRows();
+        }
+        BigInt ta, tb;
+        while (!b.isZero()) {
+            if (u == nullptr && b.blocks.size() == 1) {
+                Limb r = BigInt::DivRemLimbs(nullptr, a.blocks.data(), a.blocks.size(), BigInt::LimbDivisor(b.blocks[0]));
+                return BigInt(BinaryGcd(b.blocks[0], r));
+            }
+            if (u == nullptr && a.blocks.size() == 2) {
+                DoubleLimb g = BinaryGcd(Wide(a), Wide(b));
+                BigInt result(static_cast<Limb>(g));
+                if (g >> BigInt::LIMB_BITS)
+                    result.blocks.push_back(static_cast<Limb>(g >> BigInt::LIMB_BITS));
+                return result;
+            }
+            if (a.blocks.size() == 1) {
+                return WordEuclid(a.blocks[0], b.blocks[0], *u);
+            }
+            if (b.blocks.size() + 1 < a.blocks.size()) {
+                EuclidStep(a, b, u);
+            }
+            else if (a.blocks.size() >= BigInt::gcdThresholds().halfGcd) {
+                Matrix r = HalfGcd(a, b, u != nullptr);
+                if (u)
+                    *u = Product(r, *u);
+            }
+            else if (a.blocks.size() < 3 || !LehmerStep(a, b, u, ta, tb)) {
+                EuclidStep(a, b, u);
+            }
+        }
+        return a;
+    }
+
+    //Stein's algorithm: strip common twos, then subtract the smaller odd number
+    static Limb BinaryGcd(Limb a, Limb b) {
+        if (a == 0 || b == 0)
+            return a | b;
+        int shift = __builtin_ctzll(a | b);
+        a >>= __builtin_ctzll(a);
+        while (b != 0) {
+            b >>= __builtin_ctzll(b);
+            if (a > b)
+                std::swap(a, b);
+            b -= a;
+        }
+        return a << shift;
+    }
+    static DoubleLimb BinaryGcd(DoubleLimb a, DoubleLimb b) {
+        if (a == 0 || b == 0)
+            return a | b;
+        int shift = TrailingZeros(a | b);
+        a >>= TrailingZeros(a);
+        while (b != 0) {
+            if (((a | b) >> BigInt::LIMB_BITS) == 0)
+                return static_cast<DoubleLimb>(BinaryGcd(static_cast<Limb>(a), static_cast<Limb>(b))) << shift;
+            b >>= TrailingZeros(b);
+            if (a > b)
+                std::swap(a, b);
+            b -= a;
+        }
+        return a << shift;
+    }
+    static int TrailingZeros(DoubleLimb x) {
+        Limb low = static_cast<Limb>(x);
+        return low != 0 ? __builtin_ctzll(low) : BigInt::LIMB_BITS + __builtin_ctzll(static_cast<Limb>(x >> BigInt::LIMB_BITS));
+    }
+    static DoubleLimb Wide(const BigInt& x) {
+        DoubleLimb result = x.blocks[0];
+        if (x.blocks.size() > 1)
+            result |= static_cast<DoubleLimb>(x.blocks[1]) << BigInt::LIMB_BITS;
+        return result;
+    }
+
+    //Euclid on single limbs with the transform in 128-bit integers (its entries stay
+    //below 2^64 in magnitude), applied to u at the end
+    static BigInt WordEuclid(Limb a, Limb b, Matrix& u) {
+        typedef __int128 SignedDoubleLimb;
+        SignedDoubleLimb w[2][2] = {{1, 0}, {0, 1}};
+        while (b != 0) {
+            Limb q = a / b;
+            Limb r = a - q * b;
+            a = b;
+            b = r;
+            for (int j = 0; j < 2; ++j) {
+                SignedDoubleLimb next = w[0][j] - static_cast<SignedDoubleLimb>(q) * w[1][j];
+                w[0][j] = w[1][j];
+                w[1][j] = next;
+            }
+        }
+        Matrix step;
+        for (int i = 0; i < 2; ++i)
+            for (int j = 0; j < 2; ++j)
+                step.m[i][j] = FromWord(w[i][j]);
+        u = Product(step, u);
+        return BigInt(a);
+    }
+    static SignedBigInt FromWord(__int128 x) {
+        SignedBigInt result;
+        result.negative = x < 0;
+        result.value = BigInt(static_cast<Limb>(x < 0 ? -x : x));
+        return result;
+    }
+
+    //(a, b) -> (b, a mod b)
+    static void EuclidStep(BigInt& a, BigInt& b, Matrix* u) {
+        std::pair<BigInt, BigInt> qr = divmod(a, b);
+        if (u) {
+            SignedBigInt q{std::move(qr.first)};
+            for (int j = 0; j < u->columns; ++j) {
+                SignedBigInt next = SignedBigInt::Sub(u->m[0][j], SignedBigInt::Mul(q, u->m[1][j]));
+                u->m[0][j] = std::move(u->m[1][j]);
+                u->m[1][j] = std::move(next);
+            }
+        }
+        a = std::move(b);
+        b = std::move(qr.second);
+    }
+
+    //bits [shift, shift + 128) of x
+    static DoubleLimb Head(const BigInt& x, size_t shift) {
+        size_t limb = shift / BigInt::LIMB_BITS;
+        int bit = shift % BigInt::LIMB_BITS;
+        auto at = [&](size_t i) { return i < x.blocks.size() ? x.blocks[i] : Limb(0); };
+        DoubleLimb low = (static_cast<DoubleLimb>(at(limb + 1)) << BigInt::LIMB_BITS) | at(limb);
+        if (bit == 0)
+            return low;
+        return (low >> bit) | (static_cast<DoubleLimb>(at(limb + 2)) << (2 * BigInt::LIMB_BITS - bit));
+    }
+    //out = p * x - q * y in one pass, for a result known to be nonnegative
+    static void MulSub(BigInt& out, const BigInt& x, Limb p, const BigInt& y, Limb q) {
+        size_t n = std::max(x.blocks.size(), y.blocks.size());
+        out.blocks.resize_uninitialized(n + 1);
+        Limb carryX = 0, carryY = 0, borrow = 0;
+        for (size_t i = 0; i < n; ++i) {
+            DoubleLimb px = static_cast<DoubleLimb>(i < x.blocks.size() ? x.blocks[i] : 0) * p + carryX;
+            DoubleLimb qy = static_cast<DoubleLimb>(i < y.blocks.size() ? y.blocks[i] : 0) * q + carryY;
+            carryX = static_cast<Limb>(px >> BigInt::LIMB_BITS);
+            carryY = static_cast<Limb>(qy >> BigInt::LIMB_BITS);
+            Limb low = static_cast<Limb>(px), sub = static_cast<Limb>(qy);
+            Limb diff = low - sub;
+            Limb nextBorrow = (low < sub) | (diff < borrow);
+            out.blocks[i] = diff - borrow;
+            borrow = nextBorrow;
+        }
+        out.blocks[n] = carryX - carryY - borrow;
+        out.delete_empty_blocks();
+    }
+    //out = p * x + q * y in one pass
+    static void MulAdd(BigInt& out, const BigInt& x, Limb p, const BigInt& y, Limb q) {
+        size_t n = std::max(x.blocks.size(), y.blocks.size());
+        out.blocks.resize_uninitialized(n + 2);
+        Limb carryX = 0, carryY = 0, carry = 0;
+        for (size_t i = 0; i < n; ++i) {
+            DoubleLimb px = static_cast<DoubleLimb>(i < x.blocks.size() ? x.blocks[i] : 0) * p + carryX;
+            DoubleLimb qy = static_cast<DoubleLimb>(i < y.blocks.size() ? y.blocks[i] : 0) * q + carryY;
+            carryX = static_cast<Limb>(px >> BigInt::LIMB_BITS);
+            carryY = static_cast<Limb>(qy >> BigInt::LIMB_BITS);
+            DoubleLimb sum = static_cast<DoubleLimb>(static_cast<Limb>(px)) + static_cast<Limb>(qy) + carry;
+            out.blocks[i] = static_cast<Limb>(sum);
+            carry = static_cast<Limb>(sum >> BigInt::LIMB_BITS);
+        }
+        DoubleLimb top = static_cast<DoubleLimb>(carryX) + carryY + carry;
+        out.blocks[n] = static_cast<Limb>(top);
+        out.blocks[n + 1] = static_cast<Limb>(top >> BigInt::LIMB_BITS);
+        out.delete_empty_blocks();
+    }
+    //c * x + d * y for word-sized c, d. Along exact Euclid steps the two terms have the
+    //same sign and only their magnitudes are added
+    static SignedBigInt Combine(__int128 c, const SignedBigInt& x, __int128 d, const SignedBigInt& y) {
+        bool negativeX = x.negative != (c < 0), negativeY = y.negative != (d < 0);
+        bool zeroX = c == 0 || x.value.isZero(), zeroY = d == 0 || y.value.isZero();
+        if (negativeX != negativeY && !zeroX && !zeroY)
+            return Dot(FromWord(c), x, FromWord(d), y);
+        SignedBigInt result;
+        MulAdd(result.value, x.value, static_cast<Limb>(c < 0 ? -c : c), y.value, static_cast<Limb>(d < 0 ? -d : d));
+        result.negative = (zeroX ? negativeY : negativeX) && !result.value.isZero();
+        return result;
+    }
+    //out = c * x + d * y for c, d of opposite signs (or one of them zero)
+    static void Combine(BigInt& out, const BigInt& x, __int128 c, const BigInt& y, __int128 d) {
+        if (c >= 0 && d <= 0)
+            MulSub(out, x, static_cast<Limb>(c), y, static_cast<Limb>(-d));
+        else
+            MulSub(out, y, static_cast<Limb>(d), x, static_cast<Limb>(-c));
+    }
+
+    //n / d for positive n and d: most Euclid quotients are tiny, and a 128-bit
+    //division is far slower than a few subtractions
+    static __int128 Quotient(__int128 n, __int128 d) {
+        if ((n >> 2) < d) {
+            __int128 q = 0;
+            while (n >= d) {
+                n -= d;
+                ++q;
+            }
+            return q;
+        }
+        if ((n >> BigInt::LIMB_BITS) == 0)
+            return static_cast<Limb>(n) / static_cast<Limb>(d);
+        return n / d;
+    }
+    //Lehmer step (Knuth's Algorithm L): the Euclid quotients of the top 126 bits of a
+    //and b (same shift) are those of a and b while two bounding quotients agree. The
+    //transform, with entries below 2^63, is then applied to a and b in one pass each.
+    //False when not even one quotient was certain, the caller divides then
+    static bool LehmerStep(BigInt& a, BigInt& b, Matrix* u, BigInt& ta, BigInt& tb) {
+        typedef __int128 SignedDoubleLimb;
+        const SignedDoubleLimb limit = SignedDoubleLimb(1) << 63;
+        size_t shift = a.bitLength() - 126;
+        SignedDoubleLimb x = Head(a, shift), y = Head(b, shift);
+        SignedDoubleLimb A = 1, B = 0, C = 0, D = 1;
+        while (y + C > 0 && y + D > 0) {
+            SignedDoubleLimb q = Quotient(x + A, y + C);
+            if (q >= limit || q != Quotient(x + B, y + D))
+                break;
+            SignedDoubleLimb nextC = A - q * C, nextD = B - q * D;
+            if (nextC <= -limit || nextC >= limit || nextD <= -limit || nextD >= limit)
+                break;
+            A = C;
+            C = nextC;
+            B = D;
+            D = nextD;
+            SignedDoubleLimb nextY = x - q * y;
+            x = y;
+            y = nextY;
+        }
+        if (B == 0)
+            return false;
+        Combine(ta, a, A, b, B);
+        Combine(tb, a, C, b, D);
+        std::swap(a, ta);
+        std::swap(b, tb);
+        if (u) {
+            for (int j = 0; j < u->columns; ++j) {
+                SignedBigInt first = Combine(A, u->m[0][j], B, u->m[1][j]);
+                u->m[1][j] = Combine(C, u->m[0][j], D, u->m[1][j]);
+                u->m[0][j] = std::move(first);
+            }
+        }
+        return true;
+    }
+
+    //Euclid steps until b has at most m bits; Lehmer steps while they can't overshoot
+    static void LehmerReduce(BigInt& a, BigInt& b, size_t m, Matrix* u) {
+        BigInt ta, tb;
+        while (b.bitLength() > m) {
+            if (a.bitLength() < m + 128 || b.blocks.size() + 1 < a.blocks.size() || !LehmerStep(a, b, u, ta, tb))
+                EuclidStep(a, b, u);
+        }
+    }
+
+    //x mod 2^bits
+    static BigInt LowBits(const BigInt& x, size_t bits) {
+        size_t limbs = (bits + BigInt::LIMB_BITS - 1) / BigInt::LIMB_BITS;
+        BigInt result(x.view().slice(0, limbs));
+        if (bits % BigInt::LIMB_BITS != 0 && result.blocks.size() == limbs)
+            result.blocks.back() &= (Limb(1) << (bits % BigInt::LIMB_BITS)) - 1;
+        result.delete_empty_blocks();
+        return result;
+    }
+    //(a, b) = (a1, b1) * 2^k + r (a mod 2^k, b mod 2^k), where r reduced (a >> k, b >> k)
+    //to (a1, b1). The rows of r are flipped so that a >= b >= 0 again
+    static void ApplyToLow(BigInt& a, BigInt& b, BigInt a1, BigInt b1, size_t k, Matrix& r) {
+        SignedBigInt a0{LowBits(a, k)}, b0{LowBits(b, k)};
+        a1 <<= k;
+        b1 <<= k;
+        SignedBigInt x = SignedBigInt::Add(SignedBigInt{std::move(a1)}, Dot(r.m[0][0], a0, r.m[0][1], b0));
+        SignedBigInt y = SignedBigInt::Add(SignedBigInt{std::move(b1)}, Dot(r.m[1][0], a0, r.m[1][1], b0));
+        if (x.negative)
+            r.NegateRow(0);
+        if (y.negative)
+            r.NegateRow(1);
+        a = std::move(x.value);
+        b = std::move(y.value);
+        if (a < b) {
+            std::swap(a, b);
+            r.SwapRows();
+        }
+    }
+
+    //reduces a >= b > 0 of n bits until b has at most n / 2 bits. The top half is reduced
+    //recursively and the transform is applied to the low half; after one Euclid step a
+    //second recursion on the top of what is left brings b to n / 2 bits. With
+    //quotients of the top parts that turn out wrong the transform is still unimodular,
+    //the last Euclid steps repair the pair. Without track the result is meaningless and
+    //only the reduced pair counts
+    static Matrix HalfGcd(BigInt& a, BigInt& b, bool track) {
+        size_t n = a.bitLength();
+        size_t m = n / 2;
+        Matrix r = Matrix::Identity(2);
+        Matrix* u = track ? &r : nullptr;
+        if (b.bitLength() <= m)
+            return r;
+        if (a.blocks.size() < BigInt::gcdThresholds().halfGcdBase) {
+            LehmerReduce(a, b, m, u);
+            return r;
+        }
+        BigInt a1 = a >> m, b1 = b >> m;
+        r = HalfGcd(a1, b1, true);
+        ApplyToLow(a, b, std::move(a1), std::move(b1), m, r);
+        if (b.bitLength() <= m)
+            return r;
+        EuclidStep(a, b, u);
+        size_t l = a.bitLength();
+        if (b.bitLength() <= m || 2 * (l - m) + BigInt::LIMB_BITS >= n) {
+            LehmerReduce(a, b, m, u);
+            return r;
+        }
+        //the top 2 (l - m) bits reduce to l - m bits, m bits with the low part
+        size_t k = 2 * m - l;
+        BigInt a2 = a >> k, b2 = b >> k;
+        Matrix s = HalfGcd(a2, b2, true);
+        ApplyToLow(a, b, std::move(a2), std::move(b2), k, s);
+        if (track)
+            r = Product(s, r);
+        LehmerReduce(a, b, m, u);
+        return r;
+    }
+};
+
+inline BigInt gcd(BigIntView a, BigIntView b) {
+    return GcdSolver::Gcd(a, b);
+}
+inline ExtendedGcd extended_gcd(BigIntView a, BigIntView b) {
+    return GcdSolver::Extended(a, b);
+}
+//x in [0, m) with a * x = 1 mod m; throws std::domain_error for m = 0 or gcd(a, m) > 1
+inline BigInt mod_inverse(BigIntView a, BigIntView m) {
+    if (m.isZero()) {
+        throw std::domain_error("mod_inverse: modulus is zero");
+    }
+    ExtendedGcd e = GcdSolver::Extended(BigInt(a) % m, m);
+    if (!(e.gcd == BigInt(1))) {
+        throw std::domain_error("mod_inverse: not invertible");
+    }
+    return std::move(e.x.value) % m;
+}
+
+//integer k-th roots by Newton's method with precision doubling: the root of the top
+//half of the bits, shifted into place, is one Newton step away from the full root, so
+//every level works at its own size and the whole root costs about as much as the last
+//division. The recursion bottoms out in a hardware double
+class RootSolver {
+public:
+    //floor(sqrt(n))
+    static BigInt Sqrt(const BigInt& n) {
+        size_t bits = n.bitLength();
+        if (bits <= 2 * SQRT_DOUBLE_BITS)
+            return SqrtSmall(n);
+        size_t shift = bits / 4;
+        BigInt r = Sqrt(n >> (2 * shift)) << shift;
+        //r is below the root, so the Newton step lands at or above it, a few units
+        //off at most; (r - 1)^2 = r^2 - (2r - 1) walks down to the floor
+        r = (r + n / r) >> 1;
+        BigInt square = r.square();
+        while (square > n) {
+            square -= (r << 1) - BigInt(1);
+            r -= BigInt(1);
+        }
+        return r;
+    }
+    //floor(n^(1/k))
+    static BigInt Root(const BigInt& n, uint64_t k) {
+        if (k == 0)
+            throw std::domain_error("iroot: zero exponent");
+        if (k == 2)
+            return Sqrt(n);
+        size_t bits = n.bitLength();
+        if (k == 1 || bits <= 1)
+            return n;
+        if (k >= bits)
+            return BigInt(1);
+        size_t rootBits = (bits - 1) / k + 1;
+        if (rootBits <= ROOT_DOUBLE_BITS)
+            return BigInt(RootSmall(n, k));
+        //an error of 2^shift in the seed leaves about k 2^(2 shift - rootBits) < 1
+        size_t shift = std::max<size_t>((rootBits - (64 - __builtin_clzll(k))) / 2, 1);
+        BigInt r = Root(n >> k * shift, k) << shift;
+        BigInt power = pow(r, k - 1);
+        while (true) {
+            r = (r * BigInt(k - 1) + n / power) / BigInt(k);
+            power = pow(r, k - 1);
+            if (power * r <= n)
+                return r;
+        }
+    }
+
+    static bool IsSquare(const BigInt& n, BigInt* root) {
+        if (n.isZero()) {
+            if (root)
+                *root = BigInt(0);
+            return true;
+        }
+        //squares mod 64, 63, 65 and 11 let through 1 number in 120 or so
+        const SquareTables& tables = Tables();
+        if (!tables.mod64[BigIntView(n)[0] & 63])
+            return false;
+        unsigned int r = n % (63u * 65u * 11u);
+        if (!tables.mod63[r % 63] || !tables.mod65[r % 65] || !tables.mod11[r % 11])
+            return false;
+        BigInt s = Sqrt(n);
+        if (!(s.square() == n))
+            return false;
+        if (root)
+            *root = std::move(s);
+        return true;
+    }
+
+    //n = root^exponent with the smallest prime exponent
+    static bool IsPower(const BigInt& n, BigInt* root, uint64_t* exponent) {
+        size_t bits = n.bitLength();
+        if (bits <= 1 || IsSquare(n, root)) {
+            if (root && bits <= 1)
+                *root = n;
+            if (exponent)
+                *exponent = 2;
+            return true;
+        }
+        //a k-th power of r >= 2 has at least k + 1 bits, and k divides its trailing zeros
+        BigIntView limbs(n);
+        size_t zeros = 0;
+        while (limbs[zeros / BigInt::LIMB_BITS] == 0)
+            zeros += BigInt::LIMB_BITS;
+        zeros += __builtin_ctzll(limbs[zeros / BigInt::LIMB_BITS]);
+        std::vector<uint64_t> exponents;
+        std::vector<bool> composite(bits, false);
+        for (size_t k = 3; k < bits; k += 2) {
+            if (composite[k])
+                continue;
+            for (size_t j = k * k; j < bits; j += 2 * k)
+                composite[j] = true;
+            if (zeros == 0 || zeros % k == 0)
+                exponents.push_back(k);
+        }
+
+        //for a prime p = 1 mod k the k-th powers are 1 / k of the units mod p, so a few
+        //such p reject almost every k before any root is taken. Exponents with roots of
+        //32 bits or less go straight to the root, which is checked mod CHECK_PRIMES first
+        std::vector<uint32_t> moduli(std::begin(CHECK_PRIMES), std::end(CHECK_PRIMES));
+        std::vector<size_t> firstFilter(exponents.size() + 1);
+        for (size_t i = 0; i < exponents.size(); ++i) {
+            firstFilter[i] = moduli.size();
+            uint64_t k = exponents[i];
+            if ((bits - 1) / k + 1 <= ROOT_DOUBLE_BITS)
+                continue;
+            size_t found = 0;
+            for (uint64_t p = 2 * k + 1; p < (uint64_t(1) << 32) && found < FILTER_PRIMES &&
+                 p < 2 * k * FILTER_TRIES; p += 2 * k) {
+                if (IsPrime32(static_cast<uint32_t>(p))) {
+                    moduli.push_back(static_cast<uint32_t>(p));
+                    ++found;
+                }
+            }
+        }
+        firstFilter[exponents.size()] = moduli.size();
+        std::vector<uint32_t> residues = n.residues(moduli);
+
+        for (size_t i = 0; i < exponents.size(); ++i) {
+            uint64_t k = exponents[i];
+            bool possible = true;
+            for (size_t j = firstFilter[i]; j < firstFilter[i + 1] && possible; ++j)
+                possible = residues[j] == 0 || PowMod(residues[j], (moduli[j] - 1) / k, moduli[j]) == 1;
+            if (!possible)
+                continue;
+            BigInt r;
+            if ((bits - 1) / k + 1 <= ROOT_DOUBLE_BITS) {
+                Limb estimate = RootEstimate(n, k);
+                bool matches = false;
+                for (Limb c = estimate > 1 ? estimate - 1 : 1; c <= estimate + 1 && !matches; ++c) {
+                    matches = true;
+                    for (size_t j = 0; j < CHECK_COUNT && matches; ++j)
+                        matches = PowMod(c % CHECK_PRIMES[j], k, CHECK_PRIMES[j]) == residues[j];
+                    if (matches)
+                        r = BigInt(c);
+                }
+                if (!matches)
+                    continue;
+            }
+            else {
+                r = Root(n, k);
+            }
+            if (pow(r, k) == n) {
+                if (root)
+                    *root = std::move(r);
+                if (exponent)
+                    *exponent = k;
+                return true;
+            }
+        }
+        return false;
+    }
+
+private:
+    friend class PrimeSolver;
+
+    //sqrt of a double is correctly rounded, so below 2^104 it is off by at most one
+    static constexpr size_t SQRT_DOUBLE_BITS = 52;
+    //exp2(log2(n) / k) keeps about 40 good bits
+    static constexpr size_t ROOT_DOUBLE_BITS = 32;
+    static constexpr size_t FILTER_PRIMES = 4;
+    static constexpr uint64_t FILTER_TRIES = 64;
+    static constexpr size_t CHECK_COUNT = 3;
+    static constexpr uint32_t CHECK_PRIMES[CHECK_COUNT] = {4294967291u, 4294967279u, 4294967231u};
+
+    struct SquareTables {
+        bool mod64[64] = {};
+        bool mod63[63] = {};
+        bool mod65[65] = {};
+        bool mod11[11] = {};
+        SquareTables() {
+            for (unsigned int i = 0; i < 65; ++i) {
+                mod64[i * i % 64] = true;
+                mod63[i * i % 63] = true;
+                mod65[i * i % 65] = true;
+                mod11[i * i % 11] = true;
+            }
+        }
+    };
+    static const SquareTables& Tables() {
+        static const SquareTables tables;
+        return tables;
+    }
+
+    static BigInt SqrtSmall(const BigInt& n) {
+        BigIntView limbs(n);
+        DoubleLimb value = limbs.empty() ? 0 : limbs[0];
+        if (limbs.size() > 1)
+            value |= static_cast<DoubleLimb>(limbs[1]) << BigInt::LIMB_BITS;
+        Limb r = static_cast<Limb>(std::sqrt(static_cast<double>(value)));
+        while (static_cast<DoubleLimb>(r) * r > value)
+            --r;
+        while (static_cast<DoubleLimb>(r + 1) * (r + 1) <= value)
+            ++r;
+        return BigInt(r);
+    }
+    //n^(1/k) from the top 64 bits; the whole powers of two are taken out of the
+    //logarithm first so it stays small enough to keep its precision
+    static Limb RootEstimate(const BigInt& n, uint64_t k) {
+        BigIntView limbs(n);
+        size_t bits = n.bitLength();
+        size_t low = bits > BigInt::LIMB_BITS ? bits - BigInt::LIMB_BITS : 0;
+        size_t index = low / BigInt::LIMB_BITS, offset = low % BigInt::LIMB_BITS;
+        Limb top = limbs[index] >> offset;
+        if (offset != 0 && index + 1 < limbs.size())
+            top |= limbs[index + 1] << (BigInt::LIMB_BITS - offset);
+        double scaled = std::exp2((std::log2(static_cast<double>(top)) + static_cast<double>(low % k)) / k);
+        return static_cast<Limb>(std::ldexp(scaled, static_cast<int>(low / k)));
+    }
+    static Limb RootSmall(const BigInt& n, uint64_t k) {
+        Limb r = std::max<Limb>(RootEstimate(n, k), 1);
+        while (r > 1 && pow(BigInt(r), k) > n)
+            --r;
+        while (pow(BigInt(r + 1), k) <= n)
+            ++r;
+        return r;
+    }
+
+    static uint32_t PowMod(uint64_t base, uint64_t exponent, uint32_t modulus) {
+        uint64_t result = 1 % modulus;
+        base %= modulus;
+        for (; exponent != 0; exponent >>= 1) {
+            if (exponent & 1)
+                result = result * base % modulus;
+            base = base * base % modulus;
+        }
+        return static_cast<uint32_t>(result);
+    }
+    //Miller-Rabin with the bases 2, 7 and 61, exact below 2^32
+    static bool IsPrime32(uint32_t p) {
+        if (p < 2)
+            return false;
+        for (uint32_t small : {2u, 3u, 5u, 7u, 61u}) {
+            if (p % small == 0)
+                return p == small;
+        }
+        uint32_t odd = p - 1;
+        int twos = __builtin_ctz(odd);
+        odd >>= twos;
+        for (uint32_t base : {2u, 7u, 61u}) {
+            uint64_t x = PowMod(base, odd, p);
+            if (x == 1 || x == p - 1)
+                continue;
+            bool composite = true;
+            for (int i = 1; i < twos && composite; ++i) {
+                x = x * x % p;
+                composite = x != p - 1;
+            }
+            if (composite)
+                return false;
+        }
+        return true;
+    }
+};
+
+//floor(sqrt(n))
+inline BigInt isqrt(const BigInt& n) {
+    return RootSolver::Sqrt(n);
+}
+//floor(n^(1/k)); throws std::domain_error for k = 0
+inline BigInt iroot(const BigInt& n, uint64_t k) {
+    return RootSolver::Root(n, k);
+}
+//n = root^2, the root is stored when asked for
+inline bool is_perfect_square(const BigInt& n, BigInt* root = nullptr) {
+    return RootSolver::IsSquare(n, root);
+}
+//n = root^exponent for some exponent >= 2 (0 and 1 count); reports the smallest
+//prime exponent
+inline bool is_perfect_power(const BigInt& n, BigInt* root = nullptr, uint64_t* exponent = nullptr) {
+    return RootSolver::IsPower(n, root, exponent);
+}
+
+
+//Montgomery arithmetic for one odd modulus N with R = 2^(64 * limbs of N).
+//The setup (-N^-1 mod 2^64, R mod N, R^2 mod N) is done once in the constructor;
+//multiply/square work on caller-provided limb buffers and do not allocate.
+class MontgomeryContext {
+public:
+    explicit MontgomeryContext(const BigInt& modulus) {
+        if (modulus.isZero() || !modulus.testBit(0)) {
+            throw std::invalid_argument("MontgomeryContext needs an odd modulus");
+        }
+        mod = modulus;
+        size = mod.blocks.size();
+        n = mod.blocks.data();
+
+        Limb inverse = n[0];
+        for (int i = 0; i < 6; ++i)
+            inverse *= 2 - n[0] * inverse;
+        nInv = ~inverse + 1;
+
+        BigInt r = BigInt(1) << size * BigInt::LIMB_BITS;
+        oneM = ToLimbs(r % mod);
+        r2 = ToLimbs((r * r) % mod);
+    }
+    MontgomeryContext(const MontgomeryContext& other) = delete;
+    MontgomeryContext& operator=(const MontgomeryContext& other) = delete;
+
+    const BigInt& modulus() const { return mod; }
+    //number of limbs of every Montgomery-form buffer
+    size_t limbs() const { return size; }
+    //scratch limbs needed by multiply and square
+    size_t scratchLimbs() const { return 2 * size + 2; }
+
+    //out = a * b / R mod N; out may alias a or b
+    void multiply(Limb* out, const Limb* a, const Limb* b, Limb* scratch) const {
+        //row i adds a * b[i] and m * N at t + i, which zeroes t[i]; t stays below
+        //2N * B^(i + 1), so the carries above t[i + size] are at most 2
+        Limb* t = scratch;
+        std::fill(t, t + 2 * size + 2, 0);
+        for (size_t i = 0; i < size; ++i) {
+            AddCarry(t + i + size, BigInt::AddMul1(t + i, a, size, b[i]));
+            Limb m = t[i] * nInv;
+            AddCarry(t + i + size, BigInt::AddMul1(t + i, n, size, m));
+        }
+        FinalSubtract(out, t + size, t[2 * size]);
+    }
+    //out = a * a / R mod N; cross products are computed once and doubled
+    void square(Limb* out, const Limb* a, Limb* scratch) const {
+        Limb* t = scratch;
+        std::fill(t, t + 2 * size + 1, 0);
+        for (size_t i = 0; i + 1 < size; ++i)
+            t[i + size] = BigInt::AddMul1(t + 2 * i + 1, a + i + 1, size - i - 1, a[i]);
+        Limb shiftedOut = 0;
+        for (size_t i = 0; i < 2 * size; ++i) {
+            Limb next = t[i] >> (BigInt::LIMB_BITS - 1);
+            t[i] = (t[i] << 1) | shiftedOut;
+            shiftedOut = next;
+        }
+        Limb carry = 0;
+        for (size_t i = 0; i < size; ++i) {
+            DoubleLimb sq = static_cast<DoubleLimb>(a[i]) * a[i];
+            DoubleLimb low = static_cast<DoubleLimb>(t[2 * i]) + static_cast<Limb>(sq) + carry;
+            t[2 * i] = static_cast<Limb>(low);
+            DoubleLimb high = static_cast<DoubleLimb>(t[2 * i + 1]) + static_cast<Limb>(sq >> BigInt::LIMB_BITS)
+                            + static_cast<Limb>(low >> BigInt::LIMB_BITS);
+            t[2 * i + 1] = static_cast<Limb>(high);
+            carry = static_cast<Limb>(high >> BigInt::LIMB_BITS);
+        }
+        Reduce(out, t);
+    }
+
+    BigInt toMontgomery(const BigInt& x) const {
+        std::vector<Limb> a = ToLimbs(x < mod ? x : x % mod);
+        std::vector<Limb> scratch(scratchLimbs());
+        multiply(a.data(), a.data(), r2.data(), scratch.data());
+        return FromLimbs(a.data());
+    }
+    BigInt fromMontgomery(const BigInt& x) const {
+        std::vector<Limb> a = ToLimbs(x);
+        std::vector<Limb> scratch(scratchLimbs());
+        std::fill(scratch.begin(), scratch.end(), 0);
+        std::copy(a.begin(), a.end(), scratch.begin());
+        Reduce(a.data(), scratch.data());
+        return FromLimbs(a.data());
+    }
+
+    //base^exp mod N, sliding window over the exponent bits
+    BigInt powmod(const BigInt& base, const BigInt& exp) const {
+        Workspace work;
+        return Power(base, exp, work);
+    }
+    //many exponentiations sharing the modulus and the working buffers;
+    //exponents holds either one exponent for all bases or one per base
+    std::vector<BigInt> powmodBatch(const std::vector<BigInt>& bases, const std::vector<BigInt>& exponents) const {
+        if (exponents.size() != 1 && exponents.size() != bases.size()) {
+            throw std::invalid_argument("powmodBatch needs one exponent or one per base");
+        }
+        Workspace work;
+        std::vector<BigInt> results;
+        results.reserve(bases.size());
+        for (size_t i = 0; i < bases.size(); ++i) {
+            results.push_back(Power(bases[i], exponents[exponents.size() == 1 ? 0 : i], work));
+        }
+        return results;
+    }
+
+private:
+    struct Workspace {
+        std::vector<Limb> table;
+        std::vector<Limb> acc;
+        std::vector<Limb> scratch;
+    };
+
+    static int WindowBits(size_t expBits) {
+        if (expBits <= 24) return 1;
+        if (expBits <= 80) return 3;
+        if (expBits <= 240) return 4;
+        if (expBits <= 672) return 5;
+        return 6;
+    }
+
+    BigInt Power(const BigInt& base, const BigInt& exp, Workspace& work) const {
+        size_t bits = exp.bitLength();
+        int window = WindowBits(bits);
+        size_t entries = size_t(1) << (window - 1);
+        work.table.resize(entries * size);
+        work.acc.resize(size);
+        work.scratch.resize(scratchLimbs());
+        Limb* scratch = work.scratch.data();
+        Limb* acc = work.acc.data();
+
+        //table[k] = base^(2k + 1) in Montgomery form
+        std::vector<Limb> g = ToLimbs(base < mod ? base : base % mod);
+        Limb* table = work.table.data();
+        multiply(table, g.data(), r2.data(), scratch);
+        if (entries > 1) {
+            square(acc, table, scratch);
+            for (size_t k = 1; k < entries; ++k)
+                multiply(table + k * size, table + (k - 1) * size, acc, scratch);
+        }
+
+        std::copy(oneM.begin(), oneM.end(), acc);
+        size_t i = bits;
+        while (i > 0) {
+            if (!exp.testBit(i - 1)) {
+                square(acc, acc, scratch);
+                --i;
+                continue;
+            }
+            size_t low = i > static_cast<size_t>(window) ? i - window : 0;
+            while (!exp.testBit(low))
+                ++low;
+            size_t value = 0;
+            for (size_t b = i; b-- > low;) {
+                value = (value << 1) | exp.testBit(b);
+                square(acc, acc, scratch);
+            }
+            multiply(acc, acc, table + (value >> 1) * size, scratch);
+            i = low;
+        }
+
+        std::fill(scratch, scratch + 2 * size + 1, 0);
+        std::copy(acc, acc + size, scratch);
+        Reduce(acc, scratch);
+        return FromLimbs(acc);
+    }
+
+    //Montgomery reduction of the 2 * size limb value in t (t needs one more limb of room)
+    void Reduce(Limb* out, Limb* t) const {
+        Limb overflow = 0;
+        t[2 * size] = 0;
+        for (size_t i = 0; i < size; ++i) {
+            Limb m = t[i] * nInv;
+            Limb carry = BigInt::AddMul1(t + i, n, size, m);
+            for (size_t k = i + size; carry != 0 && k < 2 * size; ++k) {
+                t[k] += carry;
+                carry = (t[k] < carry);
+            }
+            overflow += carry;
+        }
+        FinalSubtract(out, t + size, overflow);
+    }
+
+    //out = t - N if t (with an extra top limb) is at least N, otherwise out = t
+    void FinalSubtract(Limb* out, const Limb* t, Limb top) const {
+        bool subtract = top != 0;
+        if (!subtract) {
+            subtract = true;
+            for (size_t j = size; j-- > 0;) {
+                if (t[j] != n[j]) {
+                    subtract = t[j] > n[j];
+                    break;
+                }
+            }
+        }
+        if (!subtract) {
+            std::copy(t, t + size, out);
+            return;
+        }
+        BigInt::SubN(out, t, n, size);
+    }
+    //t[0] += carry, with the carry out into t[1]
+    static void AddCarry(Limb* t, Limb carry) {
+        t[0] += carry;
+        t[1] += t[0] < carry;
+    }
+
+    std::vector<Limb> ToLimbs(const BigInt& x) const {
+        std::vector<Limb> limbs(size, 0);
+        std::copy(x.blocks.begin(), x.blocks.begin() + std::min(size, x.blocks.size()), limbs.begin());
+        return limbs;
+    }
+    BigInt FromLimbs(const Limb* limbs) const {
+        BigInt result;
+        result.blocks.assign(limbs, limbs + size);
+        result.delete_empty_blocks();
+        return result;
+    }
+
+    BigInt mod;
+    const Limb* n;
+    size_t size;
+    Limb nInv;
+    std::vector<Limb> oneM;
+    std::vector<Limb> r2;
+};
+
+
+//Barrett reduction by a fixed modulus m of k limbs. mu = floor(B^(2k) / m) is the
+//only division; afterwards x < B^(2k) is reduced with two products, shifts and masks.
+class BarrettReducer {
+public:
+    explicit BarrettReducer(const BigInt& modulus) : mod(modulus) {
+        if (modulus.isZero()) {
+            throw std::invalid_argument("BarrettReducer needs a non-zero modulus");
+        }
+        k = (modulus.bitLength() + BigInt::LIMB_BITS - 1) / BigInt::LIMB_BITS;
+        wrap = BigInt(1) << (k + 1) * BigInt::LIMB_BITS;
+        lowMask = wrap - BigInt(1);
+        mu = (BigInt(1) << 2 * k * BigInt::LIMB_BITS) / mod;
+    }
+
+    const BigInt& modulus() const { return mod; }
+
+    //x mod m; inputs wider than 2k limbs fall back to divmod
+    BigInt reduce(const BigInt& x) const {
+        if (x < mod) {
+            return x;
+        }
+        if (x.bitLength() > 2 * k * BigInt::LIMB_BITS) {
+            return x % mod;
+        }
+        BigInt q = (x >> (k - 1) * BigInt::LIMB_BITS) * mu;
+        q >>= (k + 1) * BigInt::LIMB_BITS;
+        BigInt r = x & lowMask;
+        BigInt qm = (q * mod) & lowMask;
+        if (r < qm) {
+            r += wrap;
+        }
+        r -= qm;
+        while (r >= mod) {
+            r -= mod;
+        }
+        return r;
+    }
+    //a * b mod m for reduced a and b
+    BigInt multiply(const BigInt& a, const BigInt& b) const {
+        return reduce(a * b);
+    }
+
+private:
+    friend class BigIntBatch;
+
+    BigInt mod;
+    BigInt mu;
+    BigInt wrap;
+    BigInt lowMask;
+    size_t k;
+};
+
+//probable primes: trial division, then Baillie-PSW, a strong Fermat test to base 2
+//followed by a strong Lucas test with Selfridge's parameters, both in Montgomery form.
+//No composite is known to pass both, and none exists below 2^64. Prime searches sieve
+//a window of odd candidates by the small primes first; the residues of the window
+//start are computed once and then stepped along, so only the survivors cost a big
+//operation, and with parallelism().threads > 1 the survivors are tested on the pool
+class PrimeSolver {
+public:
+    static bool IsProbablePrime(const BigInt& n) {
+        if (n.bitLength() <= 32)
+            return RootSolver::IsPrime32(n.isZero() ? 0 : static_cast<uint32_t>(BigIntView(n)[0]));
+        //n is above every trial prime, so a zero residue means composite
+        for (uint32_t r : n.residues(TrialPrimes())) {
+            if (r == 0)
+                return false;
+        }
+        return IsBpsw(n);
+    }
+    //BPSW and then rounds strong Fermat tests to bases drawn from [2, n - 2)
+    template<class Rng>
+    static bool IsProbablePrime(const BigInt& n, unsigned rounds, Rng& rng) {
+        if (!IsProbablePrime(n))
+            return false;
+        if (n.bitLength() <= 32)
+            return true;
+        MontgomeryContext ctx(n);
+        BigInt span = n - BigInt(3);
+        for (unsigned i = 0; i < rounds; ++i) {
+            BigInt base;
+            do {
+                base = BigInt::random(span.bitLength(), rng);
+            } while (!(base < span));
+            if (!IsStrongProbablePrime(ctx, base + BigInt(2)))
+                return false;
+        }
+        return true;
+    }
+
+    //smallest probable prime above n
+    static BigInt Next(const BigInt& n) {
+        BigInt start;
+        if (n.bitLength() <= 32) {
+            for (uint64_t c = (n.isZero() ? 0 : BigIntView(n)[0]) + 1; c <= UINT32_MAX; ++c) {
+                if (RootSolver::IsPrime32(static_cast<uint32_t>(c)))
+                    return BigInt(c);
+            }
+            start = BigInt((Limb(1) << 32) + 1);
+        }
+        else {
+            start = n + BigInt(n.testBit(0) ? 2 : 1);
+        }
+        BigInt found;
+        Search(start, SIZE_MAX, found);
+        return found;
+    }
+    //a probable prime of exactly bits bits: a random odd start with the top bit set,
+    //then the first prime after it
+    template<class Rng>
+    static BigInt Random(size_t bits, Rng& rng) {
+        if (bits < 2)
+            throw std::domain_error("random_prime: fewer than 2 bits");
+        BigInt top = BigInt(1) << (bits - 1);
+        while (true) {
+            BigInt start = BigInt::random(bits - 1, rng) | top;
+            if (bits <= 32) {
+                if (RootSolver::IsPrime32(static_cast<uint32_t>(BigIntView(start)[0])))
+                    return start;
+                continue;
+            }
+            start |= BigInt(1);
+            BigInt found;
+            if (Search(start, bits, found))
+                return found;
+        }
+    }
+
+private:
+    static constexpr size_t TRIAL_PRIMES = 100;
+    //sieve primes per window: 4 per bit of the candidates, between these bounds
+    static constexpr size_t MIN_SIEVE_PRIMES = 256;
+    static constexpr size_t MAX_SIEVE_PRIMES = 6000;
+    static constexpr size_t MIN_WINDOW = 512;
+
+    //the primes below 2^16
+    static const std::vector<uint32_t>& SmallPrimes() {
+        static const std::vector<uint32_t> primes = [] {
+            const uint32_t limit = 1u << 16;
+            std::vector<bool> composite(limit, false);
+            std::vector<uint32_t> result;
+            for (uint32_t p = 2; p < limit; ++p) {
+                if (composite[p])
+                    continue;
+                result.push_back(p);
+                for (uint32_t k = p * p; k < limit; k += p)
+                    composite[k] = true;
+            }
+            return result;
+        }();
+        return primes;
+    }
+    static const std::vector<uint32_t>& TrialPrimes() {
+        static const std::vector<uint32_t> primes(SmallPrimes().begin(), SmallPrimes().begin() + TRIAL_PRIMES);
+        return primes;
+    }
+
+    //n odd, above 2^32
+    static bool IsBpsw(const BigInt& n) {
+        MontgomeryContext ctx(n);
+        return IsStrongProbablePrime(ctx, BigInt(2)) && IsStrongLucas(ctx);
+    }
+
+    //with n - 1 = d 2^s: base^d = 1 or base^(d 2^r) = -1 for some r < s
+    static bool IsStrongProbablePrime(const MontgomeryContext& ctx, const BigInt& base) {
+        const BigInt& n = ctx.modulus();
+        BigInt minusOne = n - BigInt(1);
+        size_t twos = TrailingZeros(minusOne);
+        BigInt x = ctx.powmod(base, minusOne >> twos);
+        if (x == BigInt(1) || x == minusOne)
+            return true;
+        for (size_t r = 1; r < twos; ++r) {
+            x = x.square() % n;
+            if (x == minusOne)
+                return true;
+            if (x == BigInt(1))
+                return false;
+        }
+        return false;
+    }
+
+    //the sequences of x^2 - x + Q with D = 1 - 4Q: with n + 1 = d 2^s, prime n has
+    //U_d = 0 or V_(d 2^r) = 0 for some r < s. U and V are doubled and stepped along
+    //the bits of d, Q^k alongside, every value mod n in Montgomery form
+    static bool IsStrongLucas(const MontgomeryContext& ctx) {
+        const BigInt& n = ctx.modulus();
+        //Selfridge: the first D of 5, -7, 9, -11, ... with (D/n) = -1. A square has
+        //no such D, so it is ruled out once a few have failed
+        int64_t d = 5;
+        for (int tries = 0;; ++tries) {
+            int symbol = Jacobi(d, n);
+            if (symbol == -1)
+                break;
+            if (symbol == 0)
+                return false;
+            if (tries == 8 && RootSolver::IsSquare(n, nullptr))
+                return false;
+            d = d > 0 ? -(d + 2) : 2 - d;
+        }
+        int64_t q = (1 - d) / 4;
+
+        size_t size = ctx.limbs();
+        const Limb* m = BigIntView(n).data();
+        std::vector<Limb> dm = Limbs(ctx.toMontgomery(Residue(d, n)), size);
+        std::vector<Limb> qm = Limbs(ctx.toMontgomery(Residue(q, n)), size);
+        std::vector<Limb> u = Limbs(ctx.toMontgomery(BigInt(1)), size);
+        std::vector<Limb> v = u;
+        std::vector<Limb> qk = qm;
+        std::vector<Limb> t(size);
+        std::vector<Limb> scratch(ctx.scratchLimbs());
+        Limb* s = scratch.data();
+
+        BigInt k = n + BigInt(1);
+        size_t twos = TrailingZeros(k);
+        k >>= twos;
+        //U_1 = 1, V_1 = P = 1
+        for (size_t i = k.bitLength() - 1; i-- > 0;) {
+            //U_2k = U_k V_k, V_2k = V_k^2 - 2 Q^k
+            ctx.multiply(u.data(), u.data(), v.data(), s);
+            DoubleStep(ctx, v.data(), qk.data(), t.data(), s);
+            if (k.testBit(i)) {
+                //U_(k+1) = (U_k + V_k) / 2, V_(k+1) = (D U_k + V_k) / 2
+                ctx.multiply(t.data(), dm.data(), u.data(), s);
+                AddMod(u.data(), u.data(), v.data(), m, size);
+                Halve(u.data(), m, size);
+                AddMod(v.data(), v.data(), t.data(), m, size);
+                Halve(v.data(), m, size);
+                ctx.multiply(qk.data(), qk.data(), qm.data(), s);
+            }
+        }
+        if (IsZero(u.data(), size) || IsZero(v.data(), size))
+            return true;
+        for (size_t r = 1; r < twos; ++r) {
+            DoubleStep(ctx, v.data(), qk.data(), t.data(), s);
+            if (IsZero(v.data(), size))
+                return true;
+        }
+        return false;
+    }
+    //V = V^2 - 2 Q^k, then Q^k = Q^2k
+    static void DoubleStep(const MontgomeryContext& ctx, Limb* v, Limb* qk, Limb* t, Limb* scratch) {
+        size_t size = ctx.limbs();
+        const Limb* m = BigIntView(ctx.modulus()).data();
+        AddMod(t, qk, qk, m, size);
+        ctx.square(v, v, scratch);
+        SubMod(v, v, t, m, size);
+        ctx.square(qk, qk, scratch);
+    }
+
+    //first probable prime of start, start + 2, ... below 2^maxBits; start is odd and
+    //above the sieve primes. False when the candidates reach 2^maxBits
+    static bool Search(BigInt start, size_t maxBits, BigInt& found) {
+        size_t bits = start.bitLength();
+        const std::vector<uint32_t>& small = SmallPrimes();
+        size_t count = std::min(std::max(4 * bits, MIN_SIEVE_PRIMES), MAX_SIEVE_PRIMES);
+        std::vector<uint32_t> primes(small.begin() + 1, small.begin() + 1 + count);
+        std::vector<uint32_t> offsets = start.residues(primes);
+        //about four times the average gap between primes of this size
+        size_t window = std::max(2 * bits, MIN_WINDOW);
+        BigInt::ParallelScope scope;
+        ThreadPool* pool = scope.pool();
+
+        std::vector<char> composite(window);
+        std::vector<size_t> survivors;
+        while (true) {
+            size_t end = window;
+            if (maxBits != SIZE_MAX && (start + BigInt(2 * (window - 1))).bitLength() > maxBits) {
+                BigInt room = (BigInt(1) << maxBits) - start + BigInt(1);
+                end = BigIntView(room)[0] / 2;
+            }
+            std::fill(composite.begin(), composite.end(), 0);
+            for (size_t j = 0; j < primes.size(); ++j) {
+                //start + 2i = 0 mod p at i = -r / 2, and 1 / 2 = (p + 1) / 2 mod p
+                uint64_t p = primes[j];
+                for (uint64_t i = (p - offsets[j]) % p * ((p + 1) / 2) % p; i < end; i += p)
+                    composite[i] = 1;
+            }
+            survivors.clear();
+            for (size_t i = 0; i < end; ++i) {
+                if (!composite[i])
+                    survivors.push_back(i);
+            }
+            size_t first = FirstPrime(start, survivors, pool);
+            if (first != SIZE_MAX) {
+                found = start + BigInt(2 * survivors[first]);
+                return true;
+            }
+            if (end < window)
+                return false;
+            start += BigInt(2 * window);
+            for (size_t j = 0; j < primes.size(); ++j)
+                offsets[j] = static_cast<uint32_t>((offsets[j] + 2 * window) % primes[j]);
+        }
+    }
+    //index of the first survivor that is a probable prime, SIZE_MAX if none is. The
+    //threads claim survivors in order and stop past the best hit, so every survivor
+    //before it has been tested and the result is the same as in serial
+    static size_t FirstPrime(const BigInt& start, const std::vector<size_t>& survivors, ThreadPool* pool) {
+        if (pool == nullptr || survivors.size() < 2) {
+            for (size_t k = 0; k < survivors.size(); ++k) {
+                if (IsBpsw(start + BigInt(2 * survivors[k])))
+                    return k;
+            }
+            return SIZE_MAX;
+        }
+        std::atomic<size_t> next(0);
+        std::atomic<size_t> best(SIZE_MAX);
+        std::vector<std::function<void()>> tasks(std::min<size_t>(pool->size(), survivors.size()), [&] {
+            for (size_t k = next++; k < survivors.size() && k < best.load(); k = next++) {
+                if (!IsBpsw(start + BigInt(2 * survivors[k])))
+                    continue;
+                size_t current = best.load();
+                while (k < current && !best.compare_exchange_weak(current, k)) {
+                }
+            }
+        });
+        BigInt::ForkJoin(pool, std::move(tasks));
+        return best.load();
+    }
+
+    //(a/n) for odd n above |a|, by reciprocity from (n mod |a| / |a|)
+    static int Jacobi(int64_t a, const BigInt& n) {
+        uint32_t magnitude = static_cast<uint32_t>(a < 0 ? -a : a);
+        Limb low = BigIntView(n)[0];
+        int symbol = Jacobi(n % magnitude, magnitude);
+        if ((magnitude & 3) == 3 && (low & 3) == 3)
+            symbol = -symbol;
+        if (a < 0 && (low & 3) == 3)
+            symbol = -symbol;
+        return symbol;
+    }
+    //(a/m) for odd m
+    static int Jacobi(uint32_t a, uint32_t m) {
+        int symbol = 1;
+        a %= m;
+        while (a != 0) {
+            while ((a & 1) == 0) {
+                a >>= 1;
+                if ((m & 7) == 3 || (m & 7) == 5)
+                    symbol = -symbol;
+            }
+            std::swap(a, m);
+            if ((a & 3) == 3 && (m & 3) == 3)
+                symbol = -symbol;
+            a %= m;
+        }
+        return m == 1 ? symbol : 0;
+    }
+
+    static size_t TrailingZeros(const BigInt& x) {
+        size_t zeros = 0;
+        while (!x.testBit(zeros))
+            ++zeros;
+        return zeros;
+    }
+    //a mod n for |a| < n
+    static BigInt Residue(int64_t a, const BigInt& n) {
+        return a < 0 ? n - BigInt(static_cast<Limb>(-a)) : BigInt(static_cast<Limb>(a));
+    }
+    static std::vector<Limb> Limbs(const BigInt& x, size_t size) {
+        BigIntView limbs(x);
+        std::vector<Limb> result(size, 0);
+        std::copy(limbs.data(), limbs.data() + std::min(size, limbs.size()), result.begin());
+        return result;
+    }
+    static bool IsZero(const Limb* x, size_t size) {
+        return std::all_of(x, x + size, [](Limb limb) { return limb == 0; });
+    }
+    //out = a + b mod m for a, b < m
+    static void AddMod(Limb* out, const Limb* a, const Limb* b, const Limb* m, size_t size) {
+        bool subtract = BigInt::AddN(out, a, b, size) != 0;
+        if (!subtract) {
+            subtract = true;
+            for (size_t j = size; j-- > 0;) {
+                if (out[j] != m[j]) {
+                    subtract = out[j] > m[j];
+                    break;
+                }
+            }
+        }
+        if (subtract)
+            BigInt::SubN(out, out, m, size);
+    }
+    //out = a - b mod m for a, b < m
+    static void SubMod(Limb* out, const Limb* a, const Limb* b, const Limb* m, size_t size) {
+        if (BigInt::SubN(out, a, b, size) != 0)
+            BigInt::AddN(out, out, m, size);
+    }
+    //x = x / 2 mod m for odd m: odd x gets m added first
+    static void Halve(Limb* x, const Limb* m, size_t size) {
+        Limb carry = (x[0] & 1) ? BigInt::AddN(x, x, m, size) : 0;
+        for (size_t j = 0; j < size; ++j) {
+            Limb high = j + 1 < size ? x[j + 1] : carry;
+            x[j] = (x[j] >> 1) | (high << (BigInt::LIMB_BITS - 1));
+        }
+    }
+};
+
+//Baillie-PSW probable prime test; exact below 2^64
+inline bool is_probable_prime(const BigInt& n) {
+    return PrimeSolver::IsProbablePrime(n);
+}
+//Baillie-PSW and rounds more strong Fermat tests to random bases
+template<class Rng>
+inline bool is_probable_prime(const BigInt& n, unsigned rounds, Rng& rng) {
+    return PrimeSolver::IsProbablePrime(n, rounds, rng);
+}
+//smallest probable prime above n
+inline BigInt next_prime(const BigInt& n) {
+    return PrimeSolver::Next(n);
+}
+//random probable prime of exactly bits bits; throws std::domain_error below 2 bits
+template<class Rng>
+inline BigInt random_prime(size_t bits, Rng& rng) {
+    return PrimeSolver::Random(bits, rng);
+}
+
+//count numbers of limbs() limbs each, stored limb-major (structure of arrays): limb i
+//of number j is at data()[i * stride() + j]. The kernels step through a block of
+//LANES numbers at a time, so the carries of a whole block advance together in
+//vector registers; there is no per-number object or allocation
+class BigIntBatch {
+public:
+    static constexpr size_t LANES = 8;
+
+    BigIntBatch(size_t count, size_t limbs)
+        : count(count), width(limbs), lanes((count + LANES - 1) / LANES * LANES), storage(lanes * limbs, 0) {
+    }
+    //every number must fit in limbs limbs
+    BigIntBatch(const std::vector<BigInt>& numbers, size_t limbs) : BigIntBatch(numbers.size(), limbs) {
+        for (size_t j = 0; j < numbers.size(); ++j)
+            set(j, numbers[j]);
+    }
+
+    size_t size() const { return count; }
+    size_t limbs() const { return width; }
+    size_t stride() const { return lanes; }
+    Limb* data() { return storage.data(); }
+    const Limb* data() const { return storage.data(); }
+
+    void set(size_t lane, BigIntView value) {
+        size_t used = value.isZero() ? 0 : value.size();
+        if (used > width) {
+            throw std::length_error("BigIntBatch::set: number wider than the batch");
+        }
+        for (size_t i = 0; i < width; ++i)
+            storage[i * lanes + lane] = i < used ? value[i] : 0;
+    }
+    BigInt get(size_t lane) const {
+        LimbVector limbs;
+        limbs.resize_uninitialized(width);
+        for (size_t i = 0; i < width; ++i)
+            limbs[i] = storage[i * lanes + lane];
+        return BigInt(BigIntView(limbs.data(), width));
+    }
+    std::vector<BigInt> toBigInts() const {
+        std::vector<BigInt> numbers;
+        numbers.reserve(count);
+        for (size_t j = 0; j < count; ++j)
+            numbers.push_back(get(j));
+        return numbers;
+    }
+
+    //lane by lane, modulo 2^(64 * limbs())
+    BigIntBatch& operator+= (const BigIntBatch& other) {
+        CheckShape(other);
+        Kernels().add(data(), data(), other.data(), width, lanes);
+        return *this;
+    }
+    BigIntBatch operator+ (const BigIntBatch& other) const {
+        BigIntBatch result(*this);
+        result += other;
+        return result;
+    }
+    BigIntBatch& operator-= (const BigIntBatch& other) {
+        CheckShape(other);
+        Kernels().sub(data(), data(), other.data(), width, lanes);
+        return *this;
+    }
+    BigIntBatch operator- (const BigIntBatch& other) const {
+        BigIntBatch result(*this);
+        result -= other;
+        return result;
+    }
+    //full products, limbs() + other.limbs() limbs wide
+    BigIntBatch operator* (const BigIntBatch& other) const {
+        if (count != other.count) {
+            throw std::invalid_argument("BigIntBatch: batches of different sizes");
+        }
+        BigIntBatch result(count, width + other.width);
+        MulBlocks(result.data(), data(), width, other.data(), other.width, lanes);
+        return result;
+    }
+    //-1, 0 or 1 for each lane
+    std::vector<int> compare(const BigIntBatch& other) const {
+        CheckShape(other);
+        std::vector<int> result(lanes);
+        Kernels().compare(result.data(), data(), other.data(), width, lanes);
+        result.resize(count);
+        return result;
+    }
+    //every lane mod the reducer's modulus m of k limbs, as BarrettReducer::reduce does
+    //it, with the one mu shared by all lanes. Lanes must be below B^(2k), that is
+    //limbs() <= 2k; the result has k limbs
+    BigIntBatch reduce(const BarrettReducer& reducer) const {
+        size_t k = reducer.k;
+        if (width > 2 * k) {
+            throw std::length_error("BigIntBatch::reduce: numbers wider than twice the modulus");
+        }
+        //q = floor(floor(x / B^(k-1)) * mu / B^(k+1)) is the quotient or at most 2 below it
+        BigIntBatch q = Limbs(k - 1, k + 1) * Broadcast(reducer.mu, count);
+        BigIntBatch qm = q.Limbs(k + 1, k + 1) * Broadcast(reducer.mod, count);
+        //r = x - q m < 3m fits in k + 1 limbs, so both sides are taken mod B^(k+1)
+        BigIntBatch r = Limbs(0, k + 1);
+        r -= qm.Limbs(0, k + 1);
+        BigIntBatch m = Broadcast(reducer.mod, count).Limbs(0, k + 1);
+        BigIntBatch subtrahend(count, k + 1);
+        for (int round = 0; round < 2; ++round) {
+            std::vector<int> order = r.compare(m);
+            for (size_t i = 0; i < k + 1; ++i) {
+                for (size_t j = 0; j < count; ++j)
+                    subtrahend.storage[i * lanes + j] = order[j] >= 0 ? m.storage[i * lanes + j] : 0;
+            }
+            r -= subtrahend;
+        }
+        return r.Limbs(0, k);
+    }
+
+private:
+    //count lanes of value
+    static BigIntBatch Broadcast(const BigInt& value, size_t count) {
+        BigIntBatch result(count, BigIntView(value).size());
+        for (size_t j = 0; j < count; ++j)
+            result.set(j, value);
+        return result;
+    }
+    //limbs [from, from + n) of every lane, zero above limbs()
+    BigIntBatch Limbs(size_t from, size_t n) const {
+        BigIntBatch result(count, n);
+        for (size_t i = from; i < std::min(width, from + n); ++i)
+            std::copy_n(storage.data() + i * lanes, lanes, result.storage.data() + (i - from) * lanes);
+        return result;
+    }
+
+    struct KernelSet {
+        void (*add)(Limb* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes);
+        void (*sub)(Limb* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes);
+        void (*compare)(int* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes);
+    };
+
+    void CheckShape(const BigIntBatch& other) const {
+        if (count != other.count || width != other.width) {
+            throw std::invalid_argument("BigIntBatch: batches of different shapes");
+        }
+    }
+
+    //the kernel bodies are plain loops over a block of LANES numbers; they are inlined
+    //into one wrapper per instruction set, where the compiler turns them into vector code
+    template<bool Subtract>
+    __attribute__((always_inline)) static inline void AddBlocks(Limb* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes) {
+        for (size_t block = 0; block < lanes; block += LANES) {
+            Limb carry[LANES] = {0};
+            for (size_t i = 0; i < limbs; ++i) {
+                size_t at = i * lanes + block;
+                Limb x[LANES], y[LANES], r[LANES];
+                for (size_t j = 0; j < LANES; ++j) {
+                    x[j] = a[at + j];
+                    y[j] = b[at + j];
+                }
+                for (size_t j = 0; j < LANES; ++j) {
+                    if (Subtract) {
+                        Limb d = x[j] - y[j];
+                        r[j] = d - carry[j];
+                        carry[j] = static_cast<Limb>(x[j] < y[j]) | static_cast<Limb>(d < carry[j]);
+                    }
+                    else {
+                        Limb s = x[j] + y[j];
+                        r[j] = s + carry[j];
+                        carry[j] = static_cast<Limb>(s < x[j]) | static_cast<Limb>(r[j] < s);
+                    }
+                }
+                for (size_t j = 0; j < LANES; ++j)
+                    out[at + j] = r[j];
+            }
+        }
+    }
+    //schoolbook per lane, 64x64-bit products have no vector instruction. A block is
+    //copied into contiguous scratch first, since its limbs are stride() apart in the batch
+    static void MulBlocks(Limb* out, const Limb* a, size_t aLimbs, const Limb* b, size_t bLimbs, size_t lanes) {
+        std::vector<Limb> scratch((2 * aLimbs + 2 * bLimbs) * LANES);
+        Limb* x = scratch.data();
+        Limb* y = x + aLimbs * LANES;
+        Limb* acc = y + bLimbs * LANES;
+        for (size_t block = 0; block < lanes; block += LANES) {
+            for (size_t i = 0; i < aLimbs; ++i)
+                std::memcpy(x + i * LANES, a + i * lanes + block, LANES * sizeof(Limb));
+            for (size_t k = 0; k < bLimbs; ++k)
+                std::memcpy(y + k * LANES, b + k * lanes + block, LANES * sizeof(Limb));
+            std::fill(acc, acc + bLimbs * LANES, Limb(0));
+            for (size_t j = 0; j < LANES; ++j) {
+                for (size_t i = 0; i < aLimbs; ++i) {
+                    Limb carry = 0;
+                    for (size_t k = 0; k < bLimbs; ++k) {
+                        DoubleLimb product = static_cast<DoubleLimb>(x[i * LANES + j]) * y[k * LANES + j];
+                        product += acc[(i + k) * LANES + j];
+                        product += carry;
+                        acc[(i + k) * LANES + j] = static_cast<Limb>(product);
+                        carry = static_cast<Limb>(product >> BigInt::LIMB_BITS);
+                    }
+                    acc[(i + bLimbs) * LANES + j] = carry;
+                }
+            }
+            for (size_t i = 0; i < aLimbs + bLimbs; ++i)
+                std::memcpy(out + i * lanes + block, acc + i * LANES, LANES * sizeof(Limb));
+        }
+    }
+    __attribute__((always_inline)) static inline void CompareBlocks(int* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes) {
+        for (size_t block = 0; block < lanes; block += LANES) {
+            int order[LANES] = {0};
+            for (size_t i = limbs; i-- > 0;) {
+                size_t at = i * lanes + block;
+                for (size_t j = 0; j < LANES; ++j) {
+                    int here = static_cast<int>(a[at + j] > b[at + j]) - static_cast<int>(a[at + j] < b[at + j]);
+                    order[j] = order[j] != 0 ? order[j] : here;
+                }
+            }
+            for (size_t j = 0; j < LANES; ++j)
+                out[block + j] = order[j];
+        }
+    }
+
+    static void AddScalar(Limb* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes) {
+        AddBlocks<false>(out, a, b, limbs, lanes);
+    }
+    static void SubScalar(Limb* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes) {
+        AddBlocks<true>(out, a, b, limbs, lanes);
+    }
+    static void CompareScalar(int* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes) {
+        CompareBlocks(out, a, b, limbs, lanes);
+    }
+#ifdef BIGINT_X86_DISPATCH
+    __attribute__((target("avx2")))
+    static void AddAVX2(Limb* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes) {
+        AddBlocks<false>(out, a, b, limbs, lanes);
+    }
+    __attribute__((target("avx2")))
+    static void SubAVX2(Limb* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes) {
+        AddBlocks<true>(out, a, b, limbs, lanes);
+    }
+    __attribute__((target("avx2")))
+    static void CompareAVX2(int* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes) {
+        CompareBlocks(out, a, b, limbs, lanes);
+    }
+    __attribute__((target("avx512f")))
+    static void AddAVX512(Limb* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes) {
+        AddBlocks<false>(out, a, b, limbs, lanes);
+    }
+    __attribute__((target("avx512f")))
+    static void SubAVX512(Limb* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes) {
+        AddBlocks<true>(out, a, b, limbs, lanes);
+    }
+    __attribute__((target("avx512f")))
+    static void CompareAVX512(int* out, const Limb* a, const Limb* b, size_t limbs, size_t lanes) {
+        CompareBlocks(out, a, b, limbs, lanes);
+    }
+#endif
+    static const KernelSet& Kernels() {
+        static const KernelSet kernels = [] {
+            KernelSet set{AddScalar, SubScalar, CompareScalar};
+#ifdef BIGINT_X86_DISPATCH
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f"))
+                set = KernelSet{AddAVX512, SubAVX512, CompareAVX512};
+            else if (__builtin_cpu_supports("avx2"))
+                set = KernelSet{AddAVX2, SubAVX2, CompareAVX2};
+#endif
+            return set;
+        }();
+        return kernels;
+    }
+
+    size_t count;
+    size_t width;
+    size_t lanes;
+    std::vector<Limb> storage;
+};
+
+//unsigned number of exactly Bits bits (a multiple of 64) in a std::array, for
+//crypto-sized values: no allocation, no length bookkeeping, and every operation is
+//constexpr, so constants can be computed at compile time. +, -, * and << wrap
+//modulo 2^Bits; widening_add and widening_mul return the full result
+template<size_t Bits>
+class FixedBigInt {
+    static_assert(Bits > 0 && Bits % 64 == 0, "FixedBigInt needs a positive multiple of 64 bits");
+
+public:
+    static constexpr size_t LIMBS = Bits / 64;
+    static constexpr int LIMB_BITS = 64;
+
+    constexpr FixedBigInt() : limbs() {
+    }
+    constexpr FixedBigInt(Limb value) : limbs() {
+        limbs[0] = value;
+    }
+    //zero-extends or truncates
+    template<size_t OtherBits>
+    constexpr explicit FixedBigInt(const FixedBigInt<OtherBits>& other) : limbs() {
+        for (size_t i = 0; i < LIMBS && i < other.LIMBS; ++i)
+            limbs[i] = other[i];
+    }
+    //the value modulo 2^Bits
+    explicit FixedBigInt(const BigInt& number) : limbs() {
+        BigIntView view(number);
+        for (size_t i = 0; i < LIMBS && i < view.size(); ++i)
+            limbs[i] = view[i];
+    }
+    explicit operator BigInt() const {
+        return BigInt(BigIntView(limbs.data(), LIMBS));
+    }
+    static constexpr FixedBigInt fromHex(std::string_view hexStr) {
+        FixedBigInt result;
+        result.setHex(hexStr);
+        return result;
+    }
+
+    constexpr Limb operator[](size_t i) const { return limbs[i]; }
+    constexpr Limb& operator[](size_t i) { return limbs[i]; }
+    const Limb* data() const { return limbs.data(); }
+    BigIntView view() const { return BigIntView(limbs.data(), LIMBS); }
+
+    //throws std::invalid_argument on a bad digit and std::length_error when the
+    //value needs more than Bits bits
+    constexpr void setHex(std::string_view hexStr) {
+        if (hexStr.empty()) {
+            throw std::invalid_argument("FixedBigInt::setHex: empty string");
+        }
+        limbs = {};
+        size_t digit = 0;
+        for (size_t i = hexStr.size(); i-- > 0; ++digit) {
+            char c = hexStr[i];
+            Limb value = c >= '0' && c <= '9' ? c - '0' :
+                         c >= 'a' && c <= 'f' ? c - 'a' + 10 :
+                         c >= 'A' && c <= 'F' ? c - 'A' + 10 : 16;
+            if (value == 16) {
+                throw std::invalid_argument("FixedBigInt::setHex: not a hex digit");
+            }
+            if (digit >= 16 * LIMBS) {
+                if (value != 0)
+                    throw std::length_error("FixedBigInt::setHex: value wider than the type");
+                continue;
+            }
+            limbs[digit / 16] |= value << (4 * (digit % 16));
+        }
+    }
+    //same text as BigInt::getHex
+    std::string getHex() const {
+        return static_cast<BigInt>(*this).getHex();
+    }
+    std::string getBin() const {
+        return static_cast<BigInt>(*this).getBin();
+    }
+
+    constexpr bool isZero() const {
+        Limb any = 0;
+        for (size_t i = 0; i < LIMBS; ++i)
+            any |= limbs[i];
+        return any == 0;
+    }
+    constexpr size_t bitLength() const {
+        for (size_t i = LIMBS; i-- > 0;) {
+            if (limbs[i] != 0)
+                return i * LIMB_BITS + LIMB_BITS - __builtin_clzll(limbs[i]);
+        }
+        return 0;
+    }
+
+    //add, sub: modulo 2^Bits
+    constexpr FixedBigInt& operator+= (const FixedBigInt& other) {
+        AddInto(limbs.data(), other.limbs.data());
+        return *this;
+    }
+    constexpr FixedBigInt operator+ (const FixedBigInt& other) const {
+        FixedBigInt result(*this);
+        result += other;
+        return result;
+    }
+    constexpr FixedBigInt& operator-= (const FixedBigInt& other) {
+        Limb borrow = 0;
+#pragma GCC unroll 16
+        for (size_t i = 0; i < LIMBS; ++i) {
+            DoubleLimb diff = static_cast<DoubleLimb>(limbs[i]) - other.limbs[i] - borrow;
+            limbs[i] = static_cast<Limb>(diff);
+            borrow = static_cast<Limb>(diff >> LIMB_BITS) & 1;
+        }
+        return *this;
+    }
+    constexpr FixedBigInt operator- (const FixedBigInt& other) const {
+        FixedBigInt result(*this);
+        result -= other;
+        return result;
+    }
+    //the sum with its carry as the extra top limb
+    constexpr FixedBigInt<Bits + 64> widening_add(const FixedBigInt& other) const {
+        FixedBigInt<Bits + 64> result(*this);
+        result[LIMBS] = AddInto(&result[0], other.limbs.data());
+        return result;
+    }
+
+    //mul: the low Bits bits, or the full product
+    constexpr FixedBigInt operator* (const FixedBigInt& other) const {
+        FixedBigInt result;
+        for (size_t i = 0; i < LIMBS; ++i) {
+            Limb carry = 0;
+#pragma GCC unroll 16
+            for (size_t j = 0; i + j < LIMBS; ++j) {
+                DoubleLimb product = static_cast<DoubleLimb>(limbs[i]) * other.limbs[j];
+                product += result.limbs[i + j];
+                product += carry;
+                result.limbs[i + j] = static_cast<Limb>(product);
+                carry = static_cast<Limb>(product >> LIMB_BITS);
+            }
+        }
+        return result;
+    }
+    constexpr FixedBigInt& operator*= (const FixedBigInt& other) {
+        *this = *this * other;
+        return *this;
+    }
+    constexpr FixedBigInt<2 * Bits> widening_mul(const FixedBigInt& other) const {
+        FixedBigInt<2 * Bits> result;
+        for (size_t i = 0; i < LIMBS; ++i) {
+            Limb carry = 0;
+#pragma GCC unroll 16
+            for (size_t j = 0; j < LIMBS; ++j) {
+                DoubleLimb product = static_cast<DoubleLimb>(limbs[i]) * other.limbs[j];
+                product += result[i + j];
+                product += carry;
+                result[i + j] = static_cast<Limb>(product);
+                carry = static_cast<Limb>(product >> LIMB_BITS);
+            }
+            result[i + LIMBS] = carry;
+        }
+        return result;
+    }
+
+    //shifts: bits moved past either end are dropped
+    constexpr FixedBigInt& operator<<= (size_t n) {
+        if (n >= Bits) {
+            limbs = {};
+            return *this;
+        }
+        size_t words = n / LIMB_BITS;
+        int bits = n % LIMB_BITS;
+        for (size_t i = LIMBS; i-- > words;) {
+            Limb high = limbs[i - words] << bits;
+            Limb low = bits != 0 && i > words ? limbs[i - words - 1] >> (LIMB_BITS - bits) : 0;
+            limbs[i] = high | low;
+        }
+        for (size_t i = 0; i < words; ++i)
+            limbs[i] = 0;
+        return *this;
+    }
+    constexpr FixedBigInt operator<< (size_t n) const {
+        FixedBigInt result(*this);
+        result <<= n;
+        return result;
+    }
+    constexpr FixedBigInt& operator>>= (size_t n) {
+        if (n >= Bits) {
+            limbs = {};
+            return *this;
+        }
+        size_t words = n / LIMB_BITS;
+        int bits = n % LIMB_BITS;
+        for (size_t i = 0; i + words < LIMBS; ++i) {
+            Limb low = limbs[i + words] >> bits;
+            Limb high = bits != 0 && i + words + 1 < LIMBS ? limbs[i + words + 1] << (LIMB_BITS - bits) : 0;
+            limbs[i] = low | high;
+        }
+        for (size_t i = LIMBS - words; i < LIMBS; ++i)
+            limbs[i] = 0;
+        return *this;
+    }
+    constexpr FixedBigInt operator>> (size_t n) const {
+        FixedBigInt result(*this);
+        result >>= n;
+        return result;
+    }
+
+    //comparison
+    constexpr int compare(const FixedBigInt& other) const {
+        for (size_t i = LIMBS; i-- > 0;) {
+            if (limbs[i] != other.limbs[i])
+                return limbs[i] < other.limbs[i] ? -1 : 1;
+        }
+        return 0;
+    }
+    constexpr bool operator== (const FixedBigInt& other) const { return compare(other) == 0; }
+    constexpr bool operator!= (const FixedBigInt& other) const { return compare(other) != 0; }
+    constexpr bool operator< (const FixedBigInt& other) const { return compare(other) < 0; }
+    constexpr bool operator> (const FixedBigInt& other) const { return compare(other) > 0; }
+    constexpr bool operator<= (const FixedBigInt& other) const { return compare(other) <= 0; }
+    constexpr bool operator>= (const FixedBigInt& other) const { return compare(other) >= 0; }
+
+private:
+    //x[0, LIMBS) += y[0, LIMBS), returns the carry out
+    static constexpr Limb AddInto(Limb* x, const Limb* y) {
+        Limb carry = 0;
+#pragma GCC unroll 16
+        for (size_t i = 0; i < LIMBS; ++i) {
+            DoubleLimb sum = static_cast<DoubleLimb>(x[i]) + y[i] + carry;
+            x[i] = static_cast<Limb>(sum);
+            carry = static_cast<Limb>(sum >> LIMB_BITS);
+        }
+        return carry;
+    }
+
+    std::array<Limb, LIMBS> limbs;
+};
+
+#if defined(__unix__) || defined(__APPLE__)
+//a serialized BigInt file mapped read-only; view() reads the limbs in place,
+//without loading or copying the file
+class MappedBigInt {
+public:
+    explicit MappedBigInt(const std::string& path) {
+        int fd = open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw std::runtime_error("MappedBigInt: cannot open " + path);
+        }
+        struct stat info;
+        if (fstat(fd, &info) != 0 || info.st_size < static_cast<off_t>(SerializedHeader::SIZE)) {
+            close(fd);
+            throw std::runtime_error("MappedBigInt: " + path + " is not a serialized BigInt");
+        }
+        length = static_cast<size_t>(info.st_size);
+        void* mapped = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+        if (mapped == MAP_FAILED) {
+            throw std::runtime_error("MappedBigInt: cannot map " + path);
+        }
+        bytes = static_cast<const char*>(mapped);
+        try {
+            number = BigIntView::fromSerialized(bytes, length);
+        }
+        catch (...) {
+            munmap(const_cast<char*>(bytes), length);
+            throw;
+        }
+    }
+    ~MappedBigInt() {
+        munmap(const_cast<char*>(bytes), length);
+    }
+    MappedBigInt(const MappedBigInt&) = delete;
+    MappedBigInt& operator=(const MappedBigInt&) = delete;
+
+    //valid while this object lives
+    BigIntView view() const { return number; }
+
+private:
+    const char* bytes;
+    size_t length;
+    BigIntView number;
+};
+#endif
+
+#endif
@@ -0,0 +1,292 @@
+#include "BigInt.h"
+
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <random>
+
+//benchmark for BigInt: times every operator over a sweep of operand sizes and prints
+//the results as JSON on stdout (progress goes to stderr).
+//  bigint_bench [--min-bits N] [--max-bits N] [--factor F] [--ops add,mul,...]
+//               [--min-time MS] [--threads N] [--karatsuba N] [--toom3 N] [--ntt N]
+//               [--stats]
+//  bigint_bench --tune    finds the multiplication crossovers of this machine
+//With --stats, each result also carries the BigIntStats snapshot of its timed runs
+//(all zero unless built with -DBIGINT_INSTRUMENT).
+
+namespace {
+
+typedef std::chrono::steady_clock Clock;
+
+//results are folded in here so the compiler can't drop the timed work
+volatile Limb sink;
+
+void Consume(const BigInt& x) {
+    sink = sink + (x.isZero() ? 0 : x.view().data()[0]);
+}
+
+struct Sample {
+    uint64_t reps;
+    double nsPerOp;
+};
+
+//calls op until at least minSeconds have passed, doubling the batch every round
+template <class Op>
+Sample Measure(Op&& op, double minSeconds) {
+    op(); //warm up caches and the scratch arena
+    uint64_t batch = 1;
+    while (true) {
+        Clock::time_point start = Clock::now();
+        for (uint64_t i = 0; i < batch; i++) {
+            op();
+        }
+        double elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+        if (elapsed >= minSeconds || batch >= (uint64_t(1) << 40)) {
+            return {batch, elapsed * 1e9 / batch};
+        }
+        batch *= 2;
+    }
+}
+
+//exactly limbs limbs, the top one with the highest bit set (or cleared)
+BigInt RandomLimbs(size_t limbs, std::mt19937_64& rng, bool topBit = true) {
+    std::vector<Limb> words(limbs);
+    for (Limb& w : words) {
+        w = rng();
+    }
+    Limb top = Limb(1) << (BigInt::LIMB_BITS - 1);
+    words.back() = topBit ? words.back() | top : (words.back() & ~top) | (top >> 1);
+    return BigInt(BigIntView(words.data(), words.size()));
+}
+
+struct Options {
+    uint64_t minBits = 64;
+    uint64_t maxBits = uint64_t(64) << 20;
+    uint64_t factor = 4;
+    double minSeconds = 0.05;
+    std::vector<std::string> ops;
+    bool tune = false;
+    bool stats = false;
+};
+
+const char* const ALL_OPS[] = {
+    "parse_hex", "format_hex", "parse_dec", "format_dec",
+    "and", "or", "xor", "not", "shl", "shr",
+    "add", "sub", "mul", "sqr", "mod", "mod_u32",
+};
+
+bool Wanted(const Options& options, const std::string& op) {
+    return options.ops.empty()
+        || std::find(options.ops.begin(), options.ops.end(), op) != options.ops.end();
+}
+
+//stats is the JSON of a BigIntStats snapshot, or empty
+void PrintResult(bool& first, const char* op, size_t limbs, const Sample& sample, std::string stats) {
+    double limbsPerNs = limbs / sample.nsPerOp;
+    if (!stats.empty()) {
+        stats.pop_back(); //the trailing newline
+        stats = ", \"stats\": " + stats;
+    }
+    std::printf("%s    {\"op\": \"%s\", \"bits\": %llu, \"limbs\": %llu, \"reps\": %llu, "
+                "\"ns_per_op\": %.1f, \"limbs_per_ns\": %.6g%s}",
+                first ? "" : ",\n", op, (unsigned long long)(limbs * BigInt::LIMB_BITS),
+                (unsigned long long)limbs, (unsigned long long)sample.reps,
+                sample.nsPerOp, limbsPerNs, stats.c_str());
+    std::fflush(stdout);
+    std::fprintf(stderr, "%-10s %10llu bits %16.1f ns/op %12.6g limbs/ns\n", op,
+                 (unsigned long long)(limbs * BigInt::LIMB_BITS), sample.nsPerOp, limbsPerNs);
+    first = false;
+}
+
+//one entry per operator and size, operands of `limbs` limbs each
+//(the dividend of mod has twice as many)
+void RunSize(const Options& options, size_t limbs, std::mt19937_64& rng, bool& first) {
+    BigInt a = RandomLimbs(limbs, rng);
+    BigInt b = RandomLimbs(limbs, rng, false);
+    double t = options.minSeconds;
+    auto run = [&](const char* op, auto&& body) {
+        if (Wanted(options, op)) {
+            if (options.stats) {
+                BigIntStats::reset();
+            }
+            Sample sample = Measure(body, t);
+            PrintResult(first, op, limbs, sample, options.stats ? BigIntStats::snapshot().json() : "");
+        }
+    };
+
+    std::string hex = a.getHex();
+    BigInt parsed;
+    run("parse_hex", [&] { parsed.setHex(hex); Consume(parsed); });
+    run("format_hex", [&] { a.getHex(&hex[0], hex.size()); sink = sink + hex[0]; });
+    if (Wanted(options, "parse_dec") || Wanted(options, "format_dec")) {
+        std::string dec = a.getDec();
+        run("parse_dec", [&] { parsed.setDec(dec); Consume(parsed); });
+        run("format_dec", [&] { dec = a.getDec(); sink = sink + dec[0]; });
+    }
+
+    run("and", [&] { Consume(a & b); });
+    run("or", [&] { Consume(a | b); });
+    run("xor", [&] { Consume(a ^ b); });
+    run("not", [&] { Consume(~a); });
+    run("shl", [&] { Consume(a << 97); });
+    run("shr", [&] { Consume(a >> 97); });
+
+    run("add", [&] { Consume(a + b); });
+    run("sub", [&] { Consume(a - b); });
+    run("mul", [&] { Consume(a * b); });
+    run("sqr", [&] { Consume(a.square()); });
+    if (Wanted(options, "mod")) {
+        BigInt wide = RandomLimbs(2 * limbs, rng);
+        run("mod", [&] { Consume(wide % b); });
+    }
+    run("mod_u32", [&] { sink = sink + a % 4294967291u; });
+}
+
+//time of one balanced product of n limbs with the given thresholds
+double TimeMultiply(size_t n, const BigInt::MulThresholds& tiers, double minSeconds,
+                    std::mt19937_64& rng) {
+    BigInt::MulThresholds saved = BigInt::mulThresholds();
+    BigInt::mulThresholds() = tiers;
+    BigInt a = RandomLimbs(n, rng);
+    BigInt b = RandomLimbs(n, rng);
+    double ns = Measure([&] { Consume(a * b); }, minSeconds).nsPerOp;
+    BigInt::mulThresholds() = saved;
+    return ns;
+}
+
+//smallest size in [from, to] from which one level of the tier's algorithm beats the
+//tier below it. With the threshold at n, the product of size n takes the new
+//algorithm while its smaller pieces still go to the old one. Two wins in a row
+//are needed so that a single noisy sample doesn't end the search
+size_t FindCrossover(const char* name, size_t BigInt::MulThresholds::*tier,
+                     size_t from, size_t to, double minSeconds, std::mt19937_64& rng) {
+    size_t candidate = 0;
+    for (size_t n = from; n <= to; n = std::max(n + 1, n * 5 / 4)) {
+        BigInt::MulThresholds before = BigInt::mulThresholds();
+        BigInt::MulThresholds after = before;
+        before.*tier = SIZE_MAX;
+        after.*tier = n;
+        //best of three alternating runs, other load on the machine only adds time
+        double oldNs = HUGE_VAL, newNs = HUGE_VAL;
+        for (int round = 0; round < 3; round++) {
+            oldNs = std::min(oldNs, TimeMultiply(n, before, minSeconds, rng));
+            newNs = std::min(newNs, TimeMultiply(n, after, minSeconds, rng));
+        }
+        std::fprintf(stderr, "%-10s %8zu limbs %14.1f ns below %14.1f ns at tier\n",
+                     name, n, oldNs, newNs);
+        if (newNs < oldNs) {
+            if (candidate != 0) {
+                return candidate;
+            }
+            candidate = n;
+        } else {
+            candidate = 0;
+        }
+    }
+    return candidate != 0 ? candidate : to;
+}
+
+int Tune(const Options& options) {
+    std::mt19937_64 rng(1);
+    BigInt::MulThresholds& tiers = BigInt::mulThresholds();
+    //each search runs with the thresholds below it already tuned
+    tiers.karatsuba = FindCrossover("karatsuba", &BigInt::MulThresholds::karatsuba,
+                                    8, 512, options.minSeconds, rng);
+    tiers.toom3 = FindCrossover("toom3", &BigInt::MulThresholds::toom3,
+                                std::max<size_t>(tiers.karatsuba, 24), 4096,
+                                options.minSeconds, rng);
+    tiers.ntt = FindCrossover("ntt", &BigInt::MulThresholds::ntt,
+                              std::max<size_t>(tiers.toom3, 64), 65536,
+                              options.minSeconds, rng);
+    std::printf("{\n  \"karatsuba\": %zu,\n  \"toom3\": %zu,\n  \"ntt\": %zu\n}\n",
+                tiers.karatsuba, tiers.toom3, tiers.ntt);
+    return 0;
+}
+
+int Usage(const char* program) {
+    std::fprintf(stderr,
+                 "usage: %s [--min-bits N] [--max-bits N] [--factor F] [--ops a,b,...]\n"
+                 "          [--min-time MS] [--threads N] [--karatsuba N] [--toom3 N] [--ntt N]\n"
+                 "          [--stats]\n"
+                 "       %s --tune [--min-time MS]\n"
+                 "ops:", program, program);
+    for (const char* op : ALL_OPS) {
+        std::fprintf(stderr, " %s", op);
+    }
+    std::fprintf(stderr, "\n");
+    return 2;
+}
+
+} //namespace
+
+int main(int argc, char** argv) {
+    Options options;
+    for (int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--tune") {
+            options.tune = true;
+            continue;
+        }
+        if (arg == "--stats") {
+            options.stats = true;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            return Usage(argv[0]);
+        }
+        std::string value = argv[++i];
+        unsigned long long number = std::strtoull(value.c_str(), nullptr, 10);
+        if (arg == "--min-bits") {
+            options.minBits = std::max<unsigned long long>(number, 64);
+        } else if (arg == "--max-bits") {
+            options.maxBits = number;
+        } else if (arg == "--factor") {
+            options.factor = std::max<unsigned long long>(number, 2);
+        } else if (arg == "--min-time") {
+            options.minSeconds = number / 1000.0;
+        } else if (arg == "--threads") {
+            BigInt::parallelism().threads = unsigned(std::max<unsigned long long>(number, 1));
+        } else if (arg == "--karatsuba") {
+            BigInt::mulThresholds().karatsuba = number;
+        } else if (arg == "--toom3") {
+            BigInt::mulThresholds().toom3 = number;
+        } else if (arg == "--ntt") {
+            BigInt::mulThresholds().ntt = number;
+        } else if (arg == "--ops") {
+            size_t start = 0;
+            while (start <= value.size()) {
+                size_t end = std::min(value.find(',', start), value.size());
+                std::string op = value.substr(start, end - start);
+                if (std::find(std::begin(ALL_OPS), std::end(ALL_OPS), op) == std::end(ALL_OPS)) {
+                    return Usage(argv[0]);
+                }
+                options.ops.push_back(op);
+                start = end + 1;
+            }
+        } else {
+            return Usage(argv[0]);
+        }
+    }
+    if (options.tune) {
+        return Tune(options);
+    }
+    if (options.stats && !BigIntStats::enabled) {
+        std::fprintf(stderr, "--stats: counters stay zero without -DBIGINT_INSTRUMENT\n");
+    }
+
+    const BigInt::MulThresholds& tiers = BigInt::mulThresholds();
+    std::printf("{\n  \"limb_bits\": %d,\n  \"threads\": %u,\n"
+                "  \"thresholds\": {\"karatsuba\": %zu, \"toom3\": %zu, \"ntt\": %zu, "
+                "\"burnikel_ziegler\": %zu},\n  \"results\": [\n",
+                BigInt::LIMB_BITS, BigInt::parallelism().threads.load(), tiers.karatsuba,
+                tiers.toom3, tiers.ntt, BigInt::divThresholds().burnikelZiegler);
+    std::mt19937_64 rng(1);
+    bool first = true;
+    for (uint64_t bits = options.minBits; bits <= options.maxBits; bits *= options.factor) {
+        RunSize(options, (bits + BigInt::LIMB_BITS - 1) / BigInt::LIMB_BITS, rng, first);
+    }
+    std::printf("\n  ]\n}\n");
+    return 0;
+}
@@ -0,0 +1,52 @@
+#include "BigInt.h"
+
+//checks the counters of a -DBIGINT_INSTRUMENT build: a product and a division of
+//known sizes must show up as one operator call each, in the expected tiers
+static_assert(BigIntStats::enabled, "stats.cpp needs -DBIGINT_INSTRUMENT");
+
+//exactly limbs limbs
+BigInt random_limbs(size_t limbs, std::mt19937_64& rng){
+    return BigInt::random(64 * limbs, rng) | (BigInt(1) << (64 * limbs - 1));
+}
+
+int main(){
+    //the default thresholds, which the counts below follow from
+    BigInt::mulThresholds().karatsuba = 80;
+    BigInt::mulThresholds().toom3 = 240;
+    BigInt::mulThresholds().ntt = 3000;
+    BigInt::divThresholds().burnikelZiegler = 60;
+    std::mt19937_64 rng(19);
+    BigInt a = random_limbs(300, rng), b = random_limbs(300, rng);
+
+    std::cout <<"For MUL of 300 limbs:"<< std::endl;
+    //Toom-3 splits into 5 products of about 100 limbs, each a Karatsuba of 3 schoolbook halves
+    BigIntStats::reset();
+    BigInt product = a * b;
+    BigIntStats::Snapshot stats = BigIntStats::snapshot();
+    std::cout << stats.text();
+    bool mul = stats.calls[BigIntStats::Mul] == 1 && stats.sizes[BigIntStats::Mul][9] == 1
+        && stats.tierCalls[BigIntStats::Toom3] == 1 && stats.tierCalls[BigIntStats::Karatsuba] == 5
+        && stats.tierCalls[BigIntStats::Schoolbook] == 15 && stats.tierCalls[BigIntStats::Ntt] == 0;
+    std::cout <<"Correct : " <<mul<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+
+    std::cout <<"For DIVMOD of 600 by 300 limbs:"<< std::endl;
+    //Burnikel-Ziegler on blocks of 8 pieces of 38 limbs: three levels of recursion,
+    //8 Knuth D divisions at the bottom. The internal products are tiers, not calls
+    BigIntStats::reset();
+    std::pair<BigInt, BigInt> qr = divmod(product, a);
+    stats = BigIntStats::snapshot();
+    std::cout << stats.text();
+    bool div = qr.first == b && qr.second.isZero()
+        && stats.calls[BigIntStats::DivMod] == 1 && stats.sizes[BigIntStats::DivMod][10] == 1
+        && stats.calls[BigIntStats::Mul] == 0
+        && stats.tierCalls[BigIntStats::BurnikelZiegler] == 1 && stats.tierCalls[BigIntStats::KnuthD] == 8;
+    std::cout <<"Correct : " <<div<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+
+    std::cout <<"For RESET:"<< std::endl;
+    BigIntStats::reset();
+    std::cout <<"Correct : " <<(BigIntStats::snapshot().json() == BigIntStats::Snapshot().json())<<std::endl;
+    std::cout <<"_________________________"<< std::endl;
+    return 0;
+}